@@ -8,14 +8,19 @@ in float viewDistance;
 out vec4 FragColor;
 
 uniform sampler2D blockTexture;
-uniform vec3 lightDirection;
-uniform vec3 lightColor;
-uniform vec3 ambientColor;
-
-// Fog uniforms
-uniform float fogNear;
-uniform float fogFar;
-uniform vec3 fogColor;
+
+// Per-frame values shared by every program (FrameUniforms::Data)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPosition;
+    float fogNear;
+    vec3 lightDirection;
+    float fogFar;
+    vec3 lightColor;
+    vec3 ambientColor;
+    vec3 fogColor;
+};
 
 void main()
 {
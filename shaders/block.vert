@@ -1,7 +1,7 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec3 aPos;       // Block units, relative to the chunk
+layout (location = 1) in float aFace;     // CubeFace: FRONT, BACK, LEFT, RIGHT, TOP, BOTTOM
 layout (location = 2) in vec2 aTexCoord;
 
 out vec3 FragPos;
@@ -9,19 +9,41 @@ out vec3 Normal;
 out vec2 TexCoord;
 out float viewDistance;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// World block position of the chunk's (0, 0) column, set per draw
+uniform ivec2 chunkOrigin;
+
+// Per-frame values shared by every program (FrameUniforms::Data)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPosition;
+    float fogNear;
+    vec3 lightDirection;
+    float fogFar;
+    vec3 lightColor;
+    vec3 ambientColor;
+    vec3 fogColor;
+};
+
+const vec3 FACE_NORMALS[6] = vec3[6](
+    vec3(0.0, 0.0, 1.0),
+    vec3(0.0, 0.0, -1.0),
+    vec3(-1.0, 0.0, 0.0),
+    vec3(1.0, 0.0, 0.0),
+    vec3(0.0, 1.0, 0.0),
+    vec3(0.0, -1.0, 0.0)
+);
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    // Chunks are only translated, so normals need no matrix at all
+    FragPos = aPos + vec3(float(chunkOrigin.x), 0.0, float(chunkOrigin.y));
+    Normal = FACE_NORMALS[int(aFace)];
     TexCoord = aTexCoord;
 
     // Calculate distance from camera for fog
     vec4 viewPos = view * vec4(FragPos, 1.0);
     viewDistance = length(viewPos.xyz);
 
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    gl_Position = projection * viewPos;
 }
@@ -0,0 +1,36 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;       // World space
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out float viewDistance;
+
+// Per-frame values shared by every program (FrameUniforms::Data)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPosition;
+    float fogNear;
+    vec3 lightDirection;
+    float fogFar;
+    vec3 lightColor;
+    vec3 ambientColor;
+    vec3 fogColor;
+};
+
+void main()
+{
+    FragPos = aPos;
+    Normal = aNormal;
+    TexCoord = aTexCoord;
+
+    // Calculate distance from camera for fog
+    vec4 viewPos = view * vec4(FragPos, 1.0);
+    viewDistance = length(viewPos.xyz);
+
+    gl_Position = projection * viewPos;
+}
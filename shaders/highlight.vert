@@ -3,8 +3,19 @@
 layout (location = 0) in vec3 aPos;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+// Per-frame values shared by every program (FrameUniforms::Data)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPosition;
+    float fogNear;
+    vec3 lightDirection;
+    float fogFar;
+    vec3 lightColor;
+    vec3 ambientColor;
+    vec3 fogColor;
+};
 
 void main()
 {
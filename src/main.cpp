@@ -29,6 +29,7 @@ void renderGameWorld();
 void renderGameWorldFrozen(); // For paused state - no updates
 void renderSettingsMenu();
 void renderPauseMenu();
+glm::vec3 getSpawnPosition();
 
 // Window dimensions
 const unsigned int SCR_WIDTH = DEFAULT_WINDOW_WIDTH;
@@ -161,7 +162,7 @@ int main()
     }
 
     // Initialize camera - position above the ground
-    camera = new Camera(glm::vec3(8.0f, 70.0f, 8.0f));
+    camera = new Camera(getSpawnPosition());
 
     // FPS tracking variables
     int frameCount = 0;
@@ -284,6 +285,18 @@ int main()
     return 0;
 }
 
+// Spawn just above the terrain (or water surface) at the world origin column
+glm::vec3 getSpawnPosition()
+{
+    const int spawnX = 8;
+    const int spawnZ = 8;
+    int groundY = 70; // Fallback when no world exists yet
+    if (world) {
+        groundY = std::max(world->getSurfaceHeight(spawnX, spawnZ), gTerrainSettings.waterLevel);
+    }
+    return glm::vec3(spawnX + 0.5f, groundY + 3.0f, spawnZ + 0.5f);
+}
+
 // Process input using smooth GLFW key states
 void processInput(GLFWwindow* window)
 {
@@ -465,7 +478,7 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
     }
 
     // Cast a ray from camera to find targeted block
-    World::RaycastResult result = world->raycast(camera->getPosition(), camera->getFront(), 10.0f);
+    World::RaycastResult result = world->raycastCached(camera->getPosition(), camera->getFront(), 10.0f);
 
     if (result.hit) {
         if (button == GLFW_MOUSE_BUTTON_LEFT) {
@@ -531,6 +544,8 @@ void renderGameWorld()
         float renderDistanceWorldUnits = diagonalDistance * 16.0f;
         farDistance = renderDistanceWorldUnits + (3.0f * 16.0f) + 256.0f + 50.0f;
         farDistance = std::max(farDistance, 300.0f);
+        // Far terrain reaches past the chunks - keep its corners inside the far plane
+        farDistance = std::max(farDistance, world->getHorizonDistance() * 1.414f + 50.0f);
     }    glm::mat4 projection = glm::perspective(glm::radians(camera->getFOV()),
                                            (float)SCR_WIDTH / (float)SCR_HEIGHT,
                                            0.1f, farDistance);
@@ -546,7 +561,7 @@ void renderGameWorld()
 
         // Update block highlighting based on where the camera is looking
         if (mouseCaptured && camera) {
-            World::RaycastResult result = world->raycast(camera->getPosition(), camera->getFront(), 10.0f);
+            World::RaycastResult result = world->raycastCached(camera->getPosition(), camera->getFront(), 10.0f);
             if (result.hit) {
                 world->setTargetedBlock(result.blockPos);
             } else {
@@ -610,6 +625,8 @@ void renderGameWorldFrozen()
         float renderDistanceWorldUnits = diagonalDistance * 16.0f;
         farDistance = renderDistanceWorldUnits + (3.0f * 16.0f) + 256.0f + 50.0f;
         farDistance = std::max(farDistance, 300.0f);
+        // Far terrain reaches past the chunks - keep its corners inside the far plane
+        farDistance = std::max(farDistance, world->getHorizonDistance() * 1.414f + 50.0f);
     }    glm::mat4 projection = glm::perspective(glm::radians(camera->getFOV()),
                                            (float)SCR_WIDTH / (float)SCR_HEIGHT,
                                            0.1f, farDistance);
@@ -649,9 +666,40 @@ void renderSettingsMenu()
         if (ImGui::CollapsingHeader("Graphics")) {
             if (world) {
                 int renderDistance = world->getRenderDistance();
-                if (ImGui::SliderInt("Render Distance", &renderDistance, 4, 32)) {
+                if (ImGui::SliderInt("Render Distance", &renderDistance, 4, World::MAX_RENDER_DISTANCE)) {
                     world->setRenderDistance(renderDistance);
                 }
+
+                bool farTerrain = world->isFarTerrainEnabled();
+                if (ImGui::Checkbox("Far Terrain", &farTerrain)) {
+                    world->setFarTerrainEnabled(farTerrain);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Draw a low-detail heightmap of the terrain beyond the render distance");
+                }
+                if (farTerrain) {
+                    int farLevels = world->getFarTerrainLevels();
+                    if (ImGui::SliderInt("Far Terrain Levels", &farLevels, 1, FarTerrain::MAX_LEVELS)) {
+                        world->setFarTerrainLevels(farLevels);
+                    }
+                }
+
+                bool lodEnabled = world->isLodEnabled();
+                if (ImGui::Checkbox("Distant LOD Meshes", &lodEnabled)) {
+                    world->setLodEnabled(lodEnabled);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Mesh far chunks from 2x2x2 / 4x4x4 block cells");
+                }
+                if (lodEnabled) {
+                    int lod1 = world->getLodDistance(1);
+                    int lod2 = world->getLodDistance(2);
+                    bool changed = ImGui::SliderInt("2x LOD From (chunks)", &lod1, 2, World::MAX_RENDER_DISTANCE);
+                    changed |= ImGui::SliderInt("4x LOD From (chunks)", &lod2, 2, World::MAX_RENDER_DISTANCE);
+                    if (changed) {
+                        world->setLodDistances(lod1, lod2);
+                    }
+                }
             }
 
             static bool vsync = true;
@@ -682,8 +730,8 @@ void renderSettingsMenu()
                     // Regenerate world with new seed
                     world->regenerateWorld(static_cast<unsigned int>(worldSeed));
 
-                    // Reset player to default spawn position
-                    camera->position = glm::vec3(8.0f, 70.0f, 8.0f);
+                    // Reset player to the spawn position of the new terrain
+                    camera->position = getSpawnPosition();
                     camera->yaw = -90.0f;  // Face forward
                     camera->pitch = 0.0f;  // Level view
 
@@ -697,6 +745,62 @@ void renderSettingsMenu()
             if (ImGui::IsItemHovered()) {
                 ImGui::SetTooltip("Generate a new world with the current seed and reset player position");
             }
+
+            if (world) {
+                int syncInterval = world->getSaveSyncInterval();
+                if (ImGui::SliderInt("Save Sync Interval (ms)", &syncInterval, 0, 10000)) {
+                    world->setSaveSyncInterval(syncInterval);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("How often saved chunks are flushed to disk (fsync)");
+                }
+
+                int cacheBudgetMB = static_cast<int>(world->getChunkCache().getBudget() / (1024 * 1024));
+                if (ImGui::SliderInt("Chunk Cache (MB)", &cacheBudgetMB, 0, 256)) {
+                    world->setChunkCacheBudget(static_cast<size_t>(cacheBudgetMB) * 1024 * 1024);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Memory kept for recently unloaded chunks so walking back is instant");
+                }
+
+                int memoryBudgetMB = static_cast<int>(world->getMemoryManager().getBudget() / (1024 * 1024));
+                if (ImGui::SliderInt("Memory Budget (MB)", &memoryBudgetMB, 256, 8192)) {
+                    world->setMemoryBudget(static_cast<size_t>(memoryBudgetMB) * 1024 * 1024);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Chunk memory limit - the farthest chunks are unloaded and the load radius shrinks above it");
+                }
+
+                bool verticalStreaming = world->isVerticalStreaming();
+                if (ImGui::Checkbox("Vertical Streaming", &verticalStreaming)) {
+                    world->setVerticalStreaming(verticalStreaming);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Only mesh the 16-block sections near the player's height");
+                }
+                if (verticalStreaming) {
+                    int verticalRadius = world->getVerticalRadius();
+                    if (ImGui::SliderInt("Vertical Radius (sections)", &verticalRadius, 1, 8)) {
+                        world->setVerticalRadius(verticalRadius);
+                    }
+                }
+
+                bool caveCulling = world->isCaveCulling();
+                if (ImGui::Checkbox("Cave Culling", &caveCulling)) {
+                    world->setCaveCulling(caveCulling);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Skip chunks that cannot be seen through open section faces");
+                }
+
+                bool occlusionCulling = world->isOcclusionCulling();
+                if (ImGui::Checkbox("Occlusion Culling", &occlusionCulling)) {
+                    world->setOcclusionCulling(occlusionCulling);
+                }
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Skip chunks hidden behind nearby terrain (CPU depth test)");
+                }
+            }
         }ImGui::Separator();
 
         if (ImGui::Button("Back to Game")) {
@@ -0,0 +1,51 @@
+#include "frame_uniforms.h"
+#include <cstring>
+
+static_assert(sizeof(FrameUniforms::Data) == 2 * 64 + 5 * 16, "FrameUniforms::Data must match the std140 FrameData block");
+
+FrameUniforms::FrameUniforms() : UBO(0), hasData(false) {
+}
+
+FrameUniforms::~FrameUniforms() {
+    shutdown();
+}
+
+void FrameUniforms::initialize() {
+    if (UBO != 0) return;
+    glGenBuffers(1, &UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, UBO);
+    hasData = false;
+}
+
+void FrameUniforms::shutdown() {
+    if (UBO != 0) {
+        glDeleteBuffers(1, &UBO);
+        UBO = 0;
+    }
+    hasData = false;
+}
+
+bool FrameUniforms::attach(const SimpleShader& shader) const {
+    GLuint blockIndex = glGetUniformBlockIndex(shader.shaderProgram, "FrameData");
+    if (blockIndex == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(shader.shaderProgram, blockIndex, BINDING_POINT);
+    return true;
+}
+
+void FrameUniforms::update(const Data& data) {
+    if (UBO == 0) return;
+    if (hasData && std::memcmp(&data, &current, sizeof(Data)) == 0) {
+        return;
+    }
+
+    current = data;
+    hasData = true;
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &current);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "simple_shader.h"
+
+/**
+ * @file frame_uniforms.h
+ * @brief Per-frame uniform buffer for camera, lighting and fog
+ *
+ * Values that are the same for every draw in a frame live in one std140 uniform block
+ * ("FrameData" in the shaders) instead of being set by name on each program. The buffer is
+ * written once per frame, and every program that declares the block reads it through the
+ * same binding point.
+ */
+class FrameUniforms {
+public:
+    static constexpr GLuint BINDING_POINT = 0;
+
+    // Mirrors the std140 layout of the FrameData block - each vec3 shares its 16-byte slot
+    // with the float after it
+    struct Data {
+        glm::mat4 view = glm::mat4(1.0f);
+        glm::mat4 projection = glm::mat4(1.0f);
+        glm::vec3 cameraPosition = glm::vec3(0.0f);
+        float fogNear = 0.0f;
+        glm::vec3 lightDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+        float fogFar = 0.0f;
+        glm::vec3 lightColor = glm::vec3(1.0f);
+        float padding0 = 0.0f;
+        glm::vec3 ambientColor = glm::vec3(0.0f);
+        float padding1 = 0.0f;
+        glm::vec3 fogColor = glm::vec3(0.0f);
+        float padding2 = 0.0f;
+    };
+
+    FrameUniforms();
+    ~FrameUniforms();
+
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+    void initialize();
+    void shutdown();
+
+    // Point a program's FrameData block at the shared binding; false if it has no such block
+    bool attach(const SimpleShader& shader) const;
+
+    // Upload the frame's values (skipped when nothing changed since the last frame)
+    void update(const Data& data);
+    const Data& getData() const { return current; }
+
+private:
+    GLuint UBO;
+    bool hasData;
+    Data current;
+};
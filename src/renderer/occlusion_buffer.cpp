@@ -0,0 +1,163 @@
+#include "occlusion_buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+OcclusionBuffer::OcclusionBuffer(int width, int height)
+    : width(width), height(height),
+      depth(static_cast<size_t>(width) * height, std::numeric_limits<float>::infinity()),
+      viewProjection(1.0f), occluderCount(0) {
+}
+
+void OcclusionBuffer::begin(const glm::mat4& matrix) {
+    viewProjection = matrix;
+    std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::infinity());
+    occluderCount = 0;
+}
+
+bool OcclusionBuffer::projectBox(const glm::vec3& min, const glm::vec3& max, glm::vec2 screen[8],
+                                 float& minW, float& maxW) const {
+    minW = std::numeric_limits<float>::infinity();
+    maxW = 0.0f;
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z, 1.0f);
+        glm::vec4 clip = viewProjection * corner;
+        if (clip.w < NEAR_W) {
+            return false;
+        }
+        minW = std::min(minW, clip.w);
+        maxW = std::max(maxW, clip.w);
+        screen[i] = glm::vec2((clip.x / clip.w * 0.5f + 0.5f) * width,
+                              (clip.y / clip.w * 0.5f + 0.5f) * height);
+    }
+    return true;
+}
+
+static float cross(const glm::vec2& o, const glm::vec2& a, const glm::vec2& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+bool OcclusionBuffer::addOccluder(const glm::vec3& min, const glm::vec3& max) {
+    glm::vec2 screen[8];
+    float minW, maxW;
+    if (!projectBox(min, max, screen, minW, maxW)) {
+        return false;
+    }
+
+    // The silhouette of a box is the convex hull of its projected corners (monotone chain)
+    std::sort(screen, screen + 8, [](const glm::vec2& a, const glm::vec2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    glm::vec2 hull[16];
+    int count = 0;
+    for (int i = 0; i < 8; i++) {
+        while (count >= 2 && cross(hull[count - 2], hull[count - 1], screen[i]) <= 0.0f) count--;
+        hull[count++] = screen[i];
+    }
+    for (int i = 6, lower = count + 1; i >= 0; i--) {
+        while (count >= lower && cross(hull[count - 2], hull[count - 1], screen[i]) <= 0.0f) count--;
+        hull[count++] = screen[i];
+    }
+    count--;  // The last point repeats the first
+    if (count < 3) {
+        return false;
+    }
+
+    if (!rasterizeConvex(hull, count, maxW)) {
+        return false;
+    }
+    occluderCount++;
+    return true;
+}
+
+bool OcclusionBuffer::rasterizeConvex(const glm::vec2* points, int count, float depthValue) {
+    glm::vec2 lo = points[0];
+    glm::vec2 hi = points[0];
+    for (int i = 1; i < count; i++) {
+        lo = glm::min(lo, points[i]);
+        hi = glm::max(hi, points[i]);
+    }
+    int x0 = std::max(0, static_cast<int>(std::floor(lo.x)));
+    int y0 = std::max(0, static_cast<int>(std::floor(lo.y)));
+    int x1 = std::min(width - 1, static_cast<int>(std::ceil(hi.x)) - 1);
+    int y1 = std::min(height - 1, static_cast<int>(std::ceil(hi.y)) - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+
+    // Edge functions a*x + b*y + c, positive inside. Biasing each by half the pixel's extent
+    // along the edge normal accepts only pixels whose whole square is inside the polygon.
+    float a[16], b[16], c[16];
+    for (int i = 0; i < count; i++) {
+        const glm::vec2& p0 = points[i];
+        const glm::vec2& p1 = points[(i + 1) % count];
+        a[i] = p0.y - p1.y;
+        b[i] = p1.x - p0.x;
+        c[i] = -(a[i] * p0.x + b[i] * p0.y) - 0.5f * (std::fabs(a[i]) + std::fabs(b[i]));
+    }
+
+    // Per row, each edge bounds the covered pixel centers from one side, so the coverage of
+    // a convex polygon is a single span that can be filled without per-pixel edge tests
+    bool covered = false;
+    for (int y = y0; y <= y1; y++) {
+        float centerY = y + 0.5f;
+        float spanMin = x0 + 0.5f;
+        float spanMax = x1 + 0.5f;
+        for (int i = 0; i < count && spanMin <= spanMax; i++) {
+            float rowValue = b[i] * centerY + c[i];
+            if (a[i] > 0.0f) {
+                spanMin = std::max(spanMin, -rowValue / a[i]);
+            } else if (a[i] < 0.0f) {
+                spanMax = std::min(spanMax, -rowValue / a[i]);
+            } else if (rowValue < 0.0f) {
+                spanMax = spanMin - 1.0f;
+            }
+        }
+        if (spanMin > spanMax) continue;
+
+        int first = static_cast<int>(std::ceil(spanMin - 0.5f));
+        int last = static_cast<int>(std::floor(spanMax - 0.5f));
+        float* row = &depth[y * width];
+        for (int x = first; x <= last; x++) {
+            row[x] = std::min(row[x], depthValue);
+        }
+        covered |= first <= last;
+    }
+    return covered;
+}
+
+bool OcclusionBuffer::isVisible(const glm::vec3& min, const glm::vec3& max) const {
+    glm::vec2 screen[8];
+    float minW, maxW;
+    if (!projectBox(min, max, screen, minW, maxW)) {
+        return true;
+    }
+
+    glm::vec2 lo = screen[0];
+    glm::vec2 hi = screen[0];
+    for (int i = 1; i < 8; i++) {
+        lo = glm::min(lo, screen[i]);
+        hi = glm::max(hi, screen[i]);
+    }
+    // Off-screen boxes are the frustum test's call; partly off-screen ones keep their visible part
+    if (hi.x <= 0.0f || hi.y <= 0.0f || lo.x >= width || lo.y >= height) {
+        return true;
+    }
+    int x0 = std::max(0, static_cast<int>(std::floor(lo.x)));
+    int y0 = std::max(0, static_cast<int>(std::floor(lo.y)));
+    int x1 = std::min(width - 1, static_cast<int>(std::ceil(hi.x)) - 1);
+    int y1 = std::min(height - 1, static_cast<int>(std::ceil(hi.y)) - 1);
+
+    for (int y = y0; y <= y1; y++) {
+        const float* row = &depth[y * width];
+        // Branch-free over the row so the compare vectorizes
+        bool farther = false;
+        for (int x = x0; x <= x1; x++) {
+            farther |= row[x] > minW;
+        }
+        if (farther) {
+            return true;
+        }
+    }
+    return false;
+}
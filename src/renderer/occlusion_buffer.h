@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * @file occlusion_buffer.h
+ * @brief Low-resolution CPU depth buffer for software occlusion culling
+ *
+ * Each frame the buffer is cleared for a view-projection matrix, conservative occluder boxes
+ * are rasterized into it, and candidate boxes are then tested against it. Depth is the
+ * clip-space w (distance along the view axis), so it stays linear across the screen.
+ *
+ * Both directions err towards "visible":
+ *  - an occluder writes its farthest depth, and only into pixels its projected silhouette
+ *    covers completely; occluders crossing the near plane are skipped
+ *  - a candidate is tested with its nearest depth over every on-screen pixel its projection
+ *    touches; candidates crossing the near plane or entirely off-screen are reported visible,
+ *    while one crossing a screen edge is tested on its on-screen part (the rest cannot be seen)
+ *
+ * The buffer has no GL dependency, so it can be exercised headlessly.
+ */
+class OcclusionBuffer {
+public:
+    static constexpr int DEFAULT_WIDTH = 256;
+    static constexpr int DEFAULT_HEIGHT = 128;
+    static constexpr float NEAR_W = 0.1f;   // Closest projectable depth (camera near plane)
+
+    OcclusionBuffer(int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT);
+
+    // Clear to "nothing drawn" and set the projection used by the calls below
+    void begin(const glm::mat4& viewProjection);
+
+    // Rasterize a solid box; returns false if it was skipped (near plane) or covered no pixel
+    bool addOccluder(const glm::vec3& min, const glm::vec3& max);
+
+    // False only if every pixel the box could cover already holds a nearer occluder
+    bool isVisible(const glm::vec3& min, const glm::vec3& max) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Stored depth of a pixel (row 0 at the bottom of the screen); infinity when empty
+    float getDepth(int x, int y) const { return depth[y * width + x]; }
+    int getOccluderCount() const { return occluderCount; }
+
+private:
+    int width;
+    int height;
+    std::vector<float> depth;   // Row-major, width * height
+    glm::mat4 viewProjection;
+    int occluderCount;
+
+    // Project the 8 corners to pixel coordinates; false if any lies in front of NEAR_W
+    bool projectBox(const glm::vec3& min, const glm::vec3& max, glm::vec2 screen[8],
+                    float& minW, float& maxW) const;
+    // Write depthValue into pixels fully inside the convex polygon (counter-clockwise)
+    bool rasterizeConvex(const glm::vec2* points, int count, float depthValue);
+};
@@ -0,0 +1,111 @@
+#include "render_queue.h"
+#include <algorithm>
+#include <cstring>
+
+void RenderQueue::begin() {
+    items.clear();
+}
+
+uint32_t RenderQueue::depthBits(float distance) {
+    // Non-negative floats order the same as their bit patterns
+    distance = std::max(distance, 0.0f);
+    uint32_t bits;
+    std::memcpy(&bits, &distance, sizeof(bits));
+    return bits;
+}
+
+uint64_t RenderQueue::shaderIndex(SimpleShader* shader) {
+    auto it = std::find(shaders.begin(), shaders.end(), shader);
+    if (it != shaders.end()) {
+        return static_cast<uint64_t>(it - shaders.begin());
+    }
+    shaders.push_back(shader);
+    originLocations.push_back(shader->getUniformLocation("chunkOrigin"));
+    return shaders.size() - 1;
+}
+
+uint64_t RenderQueue::textureIndex(GLuint texture) {
+    auto it = std::find(textures.begin(), textures.end(), texture);
+    if (it != textures.end()) {
+        return static_cast<uint64_t>(it - textures.begin());
+    }
+    textures.push_back(texture);
+    return textures.size() - 1;
+}
+
+void RenderQueue::submit(const DrawState& state, GLuint vao, GLint first, GLsizei count,
+                         const glm::ivec2& origin, float distance) {
+    if (!state.shader || count <= 0) return;
+
+    uint32_t depth = depthBits(distance);
+    if (state.blend) {
+        depth = ~depth;  // Back to front
+    }
+    uint64_t key = (shaderIndex(state.shader) << SHADER_SHIFT) |
+                   (static_cast<uint64_t>(state.blend) << BLEND_SHIFT) |
+                   (textureIndex(state.texture) << TEXTURE_SHIFT) |
+                   depth;
+    items.push_back(DrawItem{key, vao, first, count, origin});
+}
+
+void RenderQueue::flush() {
+    stats = Stats();
+    if (items.empty()) return;
+
+    std::sort(items.begin(), items.end(), [](const DrawItem& a, const DrawItem& b) { return a.key < b.key; });
+
+    // Nothing is assumed about the state left by earlier code - the first draw sets everything
+    const uint64_t NONE = ~0ull;
+    uint64_t boundShader = NONE;
+    uint64_t boundTexture = NONE;
+    uint64_t blendState = NONE;
+    GLuint boundVAO = 0;
+    GLint originLocation = -1;
+    glm::ivec2 boundOrigin(0);
+    bool originValid = false;
+
+    for (const DrawItem& item : items) {
+        uint64_t blend = item.key >> BLEND_SHIFT;
+        uint64_t shader = (item.key >> SHADER_SHIFT) & 0xFF;
+        uint64_t texture = (item.key >> TEXTURE_SHIFT) & 0x7FFF;
+
+        if (shader != boundShader) {
+            shaders[shader]->use();
+            originLocation = originLocations[shader];
+            originValid = false;
+            boundShader = shader;
+            stats.shaderBinds++;
+        }
+        if (texture != boundTexture) {
+            if (textures[texture] != 0) {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, textures[texture]);
+                stats.textureBinds++;
+            }
+            boundTexture = texture;
+        }
+        if (blend != blendState) {
+            if (blend) {
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            } else {
+                glDisable(GL_BLEND);
+            }
+            blendState = blend;
+            stats.blendChanges++;
+        }
+        if (originLocation != -1 && (!originValid || item.origin != boundOrigin)) {
+            shaders[shader]->setIntVector2(originLocation, item.origin);
+            boundOrigin = item.origin;
+            originValid = true;
+            stats.originUploads++;
+        }
+        if (item.vao != boundVAO) {
+            glBindVertexArray(item.vao);
+            boundVAO = item.vao;
+        }
+        glDrawArrays(GL_TRIANGLES, item.first, item.count);
+        stats.draws++;
+    }
+    glBindVertexArray(0);
+}
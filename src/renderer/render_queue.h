@@ -0,0 +1,76 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "simple_shader.h"
+
+/**
+ * @file render_queue.h
+ * @brief Sorted list of draw calls that only changes GL state between groups
+ *
+ * Draws are submitted with the state they need (program, texture, blending) and their
+ * distance from the camera. flush() sorts them by a 64-bit key - blending, then program, then
+ * texture, then depth - and walks the sorted list, binding a program, texture or blend mode
+ * only when it differs from the previous draw.
+ *
+ * Opaque draws are ordered front to back so early depth testing rejects hidden fragments.
+ * Blended draws come after every opaque draw, whatever their program, back to front, so
+ * translucent surfaces composite over everything behind them.
+ */
+class RenderQueue {
+public:
+    struct DrawState {
+        SimpleShader* shader = nullptr;
+        GLuint texture = 0;         // Bound to texture unit 0; 0 leaves the unit as it is
+        bool blend = false;         // SRC_ALPHA / ONE_MINUS_SRC_ALPHA when enabled
+    };
+
+    struct Stats {
+        int draws = 0;
+        int shaderBinds = 0;
+        int textureBinds = 0;
+        int blendChanges = 0;
+        int originUploads = 0;
+    };
+
+    // Forget last frame's draws (state tables are kept)
+    void begin();
+
+    // Queue a draw of count vertices from vao; origin goes to the program's ivec2
+    // "chunkOrigin" uniform, if it has one
+    void submit(const DrawState& state, GLuint vao, GLint first, GLsizei count,
+                const glm::ivec2& origin, float distance);
+
+    // Sort and issue everything submitted since begin()
+    void flush();
+
+    size_t size() const { return items.size(); }
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct DrawItem {
+        uint64_t key;
+        GLuint vao;
+        GLint first;
+        GLsizei count;
+        glm::ivec2 origin;
+    };
+
+    // Key layout, high to low: blend (1 bit), shader index (8), texture index (15), depth (32)
+    static constexpr int BLEND_SHIFT = 63;
+    static constexpr int SHADER_SHIFT = 55;
+    static constexpr int TEXTURE_SHIFT = 40;
+
+    std::vector<DrawItem> items;
+    // Small per-frame-stable tables; keys hold indices into them
+    std::vector<SimpleShader*> shaders;
+    std::vector<GLint> originLocations;     // "chunkOrigin" uniform per shader, -1 if absent
+    std::vector<GLuint> textures;
+    Stats stats;
+
+    static uint32_t depthBits(float distance);
+    uint64_t shaderIndex(SimpleShader* shader);
+    uint64_t textureIndex(GLuint texture);
+};
@@ -69,6 +69,12 @@ void SimpleShader::setMatrix4(const std::string& name, const glm::mat4& matrix)
     }
 }
 
+void SimpleShader::setIntVector2(GLint location, const glm::ivec2& value) {
+    if (location != -1) {
+        glUniform2i(location, value.x, value.y);
+    }
+}
+
 std::string SimpleShader::loadShaderFromFile(const std::string& path) {
     std::ifstream file(path);
     std::stringstream buffer;
@@ -21,11 +21,14 @@ public:
     void setVector3(const std::string& name, const glm::vec3& value);
     void setMatrix4(const std::string& name, const glm::mat4& matrix);
 
+    // Hot paths look a location up once and set it directly (-1 is ignored)
+    GLint getUniformLocation(const std::string& name) const;
+    void setIntVector2(GLint location, const glm::ivec2& value);
+
 private:
     // Uniform location cache for performance
     mutable std::unordered_map<std::string, GLint> uniformLocationCache;
 
     std::string loadShaderFromFile(const std::string& path);
     unsigned int compileShader(const std::string& source, GLenum type);
-    GLint getUniformLocation(const std::string& name) const;
 };
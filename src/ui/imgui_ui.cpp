@@ -162,17 +162,91 @@ void ImGuiUI::renderDebugWindow(double fps, World* world, Camera* camera) {
 
     // Frustum culling statistics
     ImGui::Text("Rendered Chunks: %d", world->getRenderedChunkCount());
+    ImGui::Text("Rendered Vertices: %d (LOD chunks: %d full, %d at 2x, %d at 4x)", world->getRenderedVertexCount(),
+                world->getRenderedLodChunkCount(0), world->getRenderedLodChunkCount(1), world->getRenderedLodChunkCount(2));
+    const RenderQueue::Stats& queueStats = world->getRenderQueueStats();
+    ImGui::Text("Draw Calls: %d (%d program, %d texture, %d blend changes, %d origin uploads)", queueStats.draws,
+                queueStats.shaderBinds, queueStats.textureBinds, queueStats.blendChanges, queueStats.originUploads);
     ImGui::Text("Culled Chunks: %d", world->getCulledChunkCount());
+    if (world->isFarTerrainEnabled()) {
+        const FarTerrain& farTerrain = world->getFarTerrain();
+        ImGui::Text("Far Terrain: %zu vertices, %.1f KB, horizon %.0f blocks", farTerrain.getVertexCount(),
+                    farTerrain.getGpuBytes() / 1024.0, farTerrain.getRadius());
+    }
+    ImGui::Text("  Culled by tight Y bounds: up to %d (full-height boxes would cull %d)",
+                world->getTightBoundsCulledChunkCount(),
+                world->getCulledChunkCount() - world->getTightBoundsCulledChunkCount());
+    int frustumVisible = world->getRenderedChunkCount() + world->getOccludedChunkCount() +
+                         world->getCaveCulledChunkCount();
+    ImGui::Text("Frustum Tests: %d for %d chunks", world->getFrustumTestCount(),
+                frustumVisible + world->getCulledChunkCount());
+
+    if (world->isCaveCulling()) {
+        ImGui::Text("Cave Culled Chunks: %d (%d sections searched)", world->getCaveCulledChunkCount(),
+                    world->getCaveVisitedSectionCount());
+    }
+
+    // Occlusion culling statistics (fraction of the frustum-visible chunks that were hidden)
+    if (world->isOcclusionCulling()) {
+        float occludedFraction = frustumVisible > 0 ? (float)world->getOccludedChunkCount() / frustumVisible * 100.0f : 0.0f;
+        ImGui::Text("Occluded Chunks: %d (%.1f%% of frustum-visible, %d occluders)",
+                    world->getOccludedChunkCount(), occludedFraction, world->getOccluderCount());
+    }
 
     // Calculate culling efficiency
-    int totalChunks = world->getRenderedChunkCount() + world->getCulledChunkCount();
+    int totalChunks = frustumVisible + world->getCulledChunkCount();
     if (totalChunks > 0) {
-        float cullingEfficiency = (float)world->getCulledChunkCount() / totalChunks * 100.0f;
+        float cullingEfficiency = (float)(totalChunks - world->getRenderedChunkCount()) / totalChunks * 100.0f;
         ImGui::Text("Culling Efficiency: %.1f%%", cullingEfficiency);
     }
 
     ImGui::Separator();
 
+    ImGui::Text("Chunk Saving:");
+    ImGui::Text("Save Queue: %d chunks", world->getSaveQueueDepth());
+    ImGui::Text("Bytes Written: %.1f KB (%llu chunks)", world->getSaveBytesWritten() / 1024.0,
+                static_cast<unsigned long long>(world->getSaveChunksWritten()));
+    ImGui::Text("Coalesced Saves: %llu", static_cast<unsigned long long>(world->getSavesCoalesced()));
+    ImGui::Text("Edit Journal: %.1f KB (%zu uncommitted)", world->getJournalSize() / 1024.0,
+                world->getJournalPendingCount());
+
+    ImGui::Text("Chunk Load Latency:");
+    const ChunkLoadStats& coldLoads = world->getColdDiskLoadStats();
+    const ChunkLoadStats& revisitLoads = world->getRevisitDiskLoadStats();
+    const ChunkLoadStats& generated = world->getGeneratedLoadStats();
+    ImGui::Text("Disk (cold): %.3f ms avg (%llu)", coldLoads.averageMs(),
+                static_cast<unsigned long long>(coldLoads.count));
+    ImGui::Text("Disk (revisit): %.3f ms avg (%llu)", revisitLoads.averageMs(),
+                static_cast<unsigned long long>(revisitLoads.count));
+    ImGui::Text("Generated: %.3f ms avg (%llu)", generated.averageMs(),
+                static_cast<unsigned long long>(generated.count));
+    const ChunkLoadStats& cached = world->getCachedLoadStats();
+    ImGui::Text("Cached: %.3f ms avg (%llu)", cached.averageMs(),
+                static_cast<unsigned long long>(cached.count));
+
+    const ChunkCache& cache = world->getChunkCache();
+    ImGui::Text("Chunk Cache: %zu chunks, %.1f / %.1f MB", cache.getEntryCount(),
+                cache.getBytes() / (1024.0 * 1024.0), cache.getBudget() / (1024.0 * 1024.0));
+    ImGui::Text("Cache Hit Rate: %.1f%% (%llu hits)", cache.getHitRate() * 100.0f,
+                static_cast<unsigned long long>(cache.getHits()));
+
+    const MemoryManager& memory = world->getMemoryManager();
+    const double mb = 1024.0 * 1024.0;
+    ImGui::Text("Chunk Memory: %.1f / %.1f MB", memory.getTotalBytes() / mb, memory.getBudget() / mb);
+    ImGui::Text("  Blocks %.1f MB, GPU %.1f MB, Cache %.1f MB", memory.getBlockBytes() / mb,
+                memory.getGpuBytes() / mb, memory.getCacheBytes() / mb);
+    ImGui::Text("  Pool %.1f MB, Mesh Scratch %.1f MB", memory.getPoolBytes() / mb, memory.getMeshBytes() / mb);
+    const ChunkPool& pool = world->getChunkPool();
+    ImGui::Text("Chunk Pool: %zu pooled, %llu reused, %llu created", pool.getPooledCount(),
+                static_cast<unsigned long long>(pool.getReusedCount()),
+                static_cast<unsigned long long>(pool.getCreatedCount()));
+    ImGui::Text("Load Radius: %d / %d", world->getLoadRadius(), world->getRenderDistance());
+    ImGui::Text("Raycasts: %llu queries, %llu served from cache",
+                static_cast<unsigned long long>(world->getRaycastQueries()),
+                static_cast<unsigned long long>(world->getRaycastCacheHits()));
+
+    ImGui::Separator();
+
     ImGui::Text("Player Position:");
     glm::vec3 pos = camera->getPosition();
     ImGui::Text("X: %.2f", pos.x);
@@ -224,7 +298,7 @@ void ImGuiUI::renderBlockInteractionUI(World* world, Camera* camera, int selecte
     ImGui::Text("Selected Block: %s (Press 1-5 to change)", selectedBlockName);
 
     ImGui::Separator();    // Cast a ray to show what block we're looking at
-    World::RaycastResult result = world->raycast(camera->getPosition(), camera->getFront(), 10.0f);
+    World::RaycastResult result = world->raycastCached(camera->getPosition(), camera->getFront(), 10.0f);
 
     if (result.hit) {
         ImGui::Text("Looking at Block:");
@@ -3,6 +3,11 @@
 #include <cmath>
 #include <algorithm>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MATH_UTILS_SSE 1
+#endif
+
 namespace MathUtils {
 
     // Static random number generator
@@ -154,6 +159,93 @@ namespace MathUtils {
         return true;
     }
 
+    FrustumTest Frustum::classifyAABB(const glm::vec3& min, const glm::vec3& max) const {
+        FrustumTest result = FrustumTest::INSIDE;
+        for (const auto& plane : planes) {
+            glm::vec3 normal = glm::vec3(plane);
+
+            // Positive vertex is farthest along the normal, negative vertex the nearest
+            glm::vec3 positiveVertex = min;
+            glm::vec3 negativeVertex = max;
+            if (normal.x >= 0) { positiveVertex.x = max.x; negativeVertex.x = min.x; }
+            if (normal.y >= 0) { positiveVertex.y = max.y; negativeVertex.y = min.y; }
+            if (normal.z >= 0) { positiveVertex.z = max.z; negativeVertex.z = min.z; }
+
+            if (glm::dot(normal, positiveVertex) + plane.w < 0.0f) {
+                return FrustumTest::OUTSIDE;
+            }
+            if (glm::dot(normal, negativeVertex) + plane.w < 0.0f) {
+                result = FrustumTest::INTERSECTS;
+            }
+        }
+        return result;
+    }
+
+    // Positive-vertex coordinates of box i for a plane: the max side where the normal is
+    // non-negative, so each plane picks whole arrays instead of branching per box
+    struct PlaneVertexArrays {
+        const float* x;
+        const float* y;
+        const float* z;
+
+        PlaneVertexArrays(const glm::vec4& plane, const AABBBatch& boxes)
+            : x(plane.x >= 0 ? boxes.maxX.data() : boxes.minX.data()),
+              y(plane.y >= 0 ? boxes.maxY.data() : boxes.minY.data()),
+              z(plane.z >= 0 ? boxes.maxZ.data() : boxes.minZ.data()) {}
+    };
+
+    static bool isBoxVisible(const std::array<glm::vec4, 6>& planes, const AABBBatch& boxes, size_t i) {
+        for (const auto& plane : planes) {
+            PlaneVertexArrays vertex(plane, boxes);
+            if (plane.x * vertex.x[i] + plane.y * vertex.y[i] + plane.z * vertex.z[i] + plane.w < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Frustum::containsAABBsScalar(const AABBBatch& boxes, std::vector<uint32_t>& visibleMask) const {
+        visibleMask.assign((boxes.size() + 31) / 32, 0u);
+        for (size_t i = 0; i < boxes.size(); i++) {
+            if (isBoxVisible(planes, boxes, i)) {
+                visibleMask[i / 32] |= 1u << (i % 32);
+            }
+        }
+    }
+
+    void Frustum::containsAABBs(const AABBBatch& boxes, std::vector<uint32_t>& visibleMask) const {
+#ifdef MATH_UTILS_SSE
+        visibleMask.assign((boxes.size() + 31) / 32, 0u);
+
+        size_t count = boxes.size();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 visible = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());   // All lanes set
+            for (const auto& plane : planes) {
+                PlaneVertexArrays vertex(plane, boxes);
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(vertex.x + i)),
+                                          _mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(vertex.y + i))),
+                               _mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(vertex.z + i))),
+                    _mm_set1_ps(plane.w));
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+            }
+
+            // i is a multiple of 4, so the four bits never straddle a mask word
+            uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(visible));
+            visibleMask[i / 32] |= bits << (i % 32);
+        }
+
+        for (; i < count; i++) {
+            if (isBoxVisible(planes, boxes, i)) {
+                visibleMask[i / 32] |= 1u << (i % 32);
+            }
+        }
+#else
+        containsAABBsScalar(boxes, visibleMask);
+#endif
+    }
+
     bool Frustum::containsSphere(const glm::vec3& center, float radius) const {
         for (const auto& plane : planes) {
             if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
@@ -193,6 +285,16 @@ namespace MathUtils {
         max = glm::max(max, point);
     }
 
+    void AABBBatch::clear() {
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+    }
+
+    void AABBBatch::add(const glm::vec3& min, const glm::vec3& max) {
+        minX.push_back(min.x); minY.push_back(min.y); minZ.push_back(min.z);
+        maxX.push_back(max.x); maxY.push_back(max.y); maxZ.push_back(max.z);
+    }
+
     void AABB::expand(const AABB& other) {
         min = glm::min(min, other.min);
         max = glm::max(max, other.max);
@@ -4,6 +4,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <array>
+#include <cstdint>
 #include <vector>
 
 namespace MathUtils {
@@ -41,12 +42,34 @@ namespace MathUtils {
     glm::vec3 randomVec3(float min = -1.0f, float max = 1.0f);
 
     // Frustum utilities
+    enum class FrustumTest {
+        OUTSIDE,     // Entirely behind at least one plane
+        INTERSECTS,  // Straddles a plane
+        INSIDE       // In front of every plane
+    };
+
+    // Boxes in structure-of-arrays layout for batched frustum tests
+    struct AABBBatch {
+        std::vector<float> minX, minY, minZ;
+        std::vector<float> maxX, maxY, maxZ;
+
+        void clear();
+        void add(const glm::vec3& min, const glm::vec3& max);
+        size_t size() const { return minX.size(); }
+    };
+
     struct Frustum {
         std::array<glm::vec4, 6> planes; // Left, Right, Bottom, Top, Near, Far
 
         void updateFromMatrix(const glm::mat4& viewProjection);
         bool containsPoint(const glm::vec3& point) const;
         bool containsAABB(const glm::vec3& min, const glm::vec3& max) const;
+        // Like containsAABB, but also reports boxes that need no further tests for their contents
+        FrustumTest classifyAABB(const glm::vec3& min, const glm::vec3& max) const;
+        // containsAABB over a whole batch: bit i of visibleMask (word i / 32) is set when box i
+        // is at least partly inside. Four boxes per step with SSE, scalar elsewhere.
+        void containsAABBs(const AABBBatch& boxes, std::vector<uint32_t>& visibleMask) const;
+        void containsAABBsScalar(const AABBBatch& boxes, std::vector<uint32_t>& visibleMask) const;
         bool containsSphere(const glm::vec3& center, float radius) const;
     };
 
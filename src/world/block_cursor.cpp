@@ -0,0 +1,35 @@
+#include "block_cursor.h"
+#include "world.h"
+
+BlockCursor::BlockCursor(const World* world, int worldX, int worldY, int worldZ)
+    : world(world), chunk(nullptr), blocks(nullptr), localX(0), y(0), localZ(0) {
+    moveTo(worldX, worldY, worldZ);
+}
+
+BlockCursor::BlockCursor(const World* world, const glm::ivec3& worldPos)
+    : BlockCursor(world, worldPos.x, worldPos.y, worldPos.z) {
+}
+
+void BlockCursor::moveTo(int worldX, int worldY, int worldZ) {
+    chunkCoord = ChunkUtils::worldToChunkCoord(worldX, worldZ);
+    localX = CurrentChunkGeometry::worldToLocalX(worldX);
+    localZ = CurrentChunkGeometry::worldToLocalZ(worldZ);
+    y = worldY;
+    resolveChunk();
+}
+
+void BlockCursor::step(CubeFace face) {
+    switch (face) {
+        case CubeFace::FRONT:  moveZ(1); break;
+        case CubeFace::BACK:   moveZ(-1); break;
+        case CubeFace::LEFT:   moveX(-1); break;
+        case CubeFace::RIGHT:  moveX(1); break;
+        case CubeFace::TOP:    moveY(1); break;
+        case CubeFace::BOTTOM: moveY(-1); break;
+    }
+}
+
+void BlockCursor::resolveChunk() {
+    chunk = world ? world->getChunk(chunkCoord) : nullptr;
+    blocks = chunk ? chunk->getBlockData() : nullptr;
+}
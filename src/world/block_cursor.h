@@ -0,0 +1,70 @@
+#pragma once
+
+#include "chunk.h"
+#include <glm/glm.hpp>
+
+class World;
+
+/**
+ * @file block_cursor.h
+ * @brief Read cursor over world blocks for spatially coherent access
+ *
+ * World::getBlock hashes the chunk map on every call. A cursor resolves its chunk once and
+ * keeps the chunk's block pointer plus the local position; relative moves only adjust the
+ * local coordinates and look up a new chunk when they cross a chunk border.
+ *
+ * Unloaded chunks and positions outside 0..CHUNK_HEIGHT-1 read as air (like World::getBlock).
+ * The cursor is read-only - edits still go through World::setBlock so they are journaled and
+ * remeshed. It must not outlive a chunk load or unload.
+ */
+class BlockCursor {
+public:
+    BlockCursor(const World* world, int worldX, int worldY, int worldZ);
+    BlockCursor(const World* world, const glm::ivec3& worldPos);
+
+    void moveTo(int worldX, int worldY, int worldZ);
+
+    // Relative moves - only crossing a chunk border costs a chunk lookup
+    void moveX(int dx) {
+        localX += dx;
+        if (localX & ~CurrentChunkGeometry::WIDTH_MASK) {
+            chunkCoord.x += localX >> CurrentChunkGeometry::WIDTH_SHIFT;
+            localX &= CurrentChunkGeometry::WIDTH_MASK;
+            resolveChunk();
+        }
+    }
+    void moveY(int dy) { y += dy; }
+    void moveZ(int dz) {
+        localZ += dz;
+        if (localZ & ~CurrentChunkGeometry::DEPTH_MASK) {
+            chunkCoord.z += localZ >> CurrentChunkGeometry::DEPTH_SHIFT;
+            localZ &= CurrentChunkGeometry::DEPTH_MASK;
+            resolveChunk();
+        }
+    }
+    void step(CubeFace face);
+
+    BlockData get() const {
+        if (!blocks || (y & ~CurrentChunkGeometry::HEIGHT_MASK)) {
+            return BlockData(BlockType::AIR);
+        }
+        return blocks[CurrentChunkGeometry::blockIndex(localX, y, localZ)];
+    }
+
+    // True when the chunk under the cursor is loaded (regardless of y)
+    bool isLoaded() const { return chunk != nullptr; }
+    const Chunk* getChunk() const { return chunk; }
+    glm::ivec3 getPosition() const {
+        return glm::ivec3(CurrentChunkGeometry::chunkToWorldX(chunkCoord.x) + localX, y,
+                          CurrentChunkGeometry::chunkToWorldZ(chunkCoord.z) + localZ);
+    }
+
+private:
+    const World* world;
+    const Chunk* chunk;
+    const BlockData* blocks;
+    ChunkCoord chunkCoord;
+    int localX, y, localZ;
+
+    void resolveChunk();
+};
@@ -0,0 +1,112 @@
+#include "cave_culler.h"
+#include <cmath>
+
+namespace {
+    constexpr uint8_t START_NODE = 6;
+
+    // Neighbour offsets per CubeFace (FRONT +z, BACK -z, LEFT -x, RIGHT +x, TOP +y, BOTTOM -y)
+    constexpr int FACE_DX[6] = {0, 0, -1, 1, 0, 0};
+    constexpr int FACE_DY[6] = {0, 0, 0, 0, 1, -1};
+    constexpr int FACE_DZ[6] = {1, -1, 0, 0, 0, 0};
+
+    constexpr int oppositeFace(int face) { return face ^ 1; }
+}
+
+void CaveCuller::update(const glm::vec3& cameraPos, const MathUtils::Frustum& frustum, int searchRadius,
+                        int minSection, int maxSection, const ConnectivityLookup& getConnectivity) {
+    using Geometry = CurrentChunkGeometry;
+
+    visitedSections = 0;
+    int cameraY = static_cast<int>(std::floor(cameraPos.y));
+    active = cameraY >= 0 && cameraY < CHUNK_HEIGHT;
+    if (!active) {
+        return;
+    }
+
+    radius = searchRadius;
+    gridSize = 2 * radius + 1;
+    ChunkCoord cameraChunk = ChunkUtils::worldToChunkCoord(static_cast<int>(std::floor(cameraPos.x)),
+                                                           static_cast<int>(std::floor(cameraPos.z)));
+    gridOrigin = ChunkCoord(cameraChunk.x - radius, cameraChunk.z - radius);
+
+    size_t columnCount = static_cast<size_t>(gridSize) * gridSize;
+    columns.assign(columnCount, nullptr);
+    reached.assign(columnCount, std::bitset<Geometry::SECTION_COUNT>());
+    enteredFaces.assign(columnCount * Geometry::SECTION_COUNT, 0);
+    for (int gridZ = 0; gridZ < gridSize; gridZ++) {
+        for (int gridX = 0; gridX < gridSize; gridX++) {
+            columns[columnIndex(gridX, gridZ)] = getConnectivity(ChunkCoord(gridOrigin.x + gridX, gridOrigin.z + gridZ));
+        }
+    }
+
+    const glm::vec3 sectionSize(CHUNK_WIDTH, Geometry::SECTION_HEIGHT, CHUNK_DEPTH);
+    int startSection = cameraY >> Geometry::SECTION_SHIFT;
+    queue.clear();
+    queue.push_back(Node{radius, radius, startSection, START_NODE, 0});
+    reached[columnIndex(radius, radius)].set(startSection);
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        Node node = queue[head];
+        int column = columnIndex(node.gridX, node.gridZ);
+
+        // Unloaded columns and unmeshed sections draw nothing, so they cannot block the view
+        uint16_t links = Chunk::ALL_FACES_CONNECTED;
+        const uint16_t* connectivity = columns[column];
+        if (node.enteredFrom != START_NODE && connectivity && node.section >= minSection && node.section <= maxSection) {
+            links = connectivity[node.section];
+        }
+
+        for (int face = 0; face < 6; face++) {
+            if (node.directions & (1u << oppositeFace(face))) continue;  // Would turn back
+            if (node.enteredFrom != START_NODE &&
+                !(links & Chunk::facePairBit(static_cast<CubeFace>(node.enteredFrom), static_cast<CubeFace>(face)))) {
+                continue;
+            }
+
+            int nextX = node.gridX + FACE_DX[face];
+            int nextZ = node.gridZ + FACE_DZ[face];
+            int nextSection = node.section + FACE_DY[face];
+            if (nextX < 0 || nextX >= gridSize || nextZ < 0 || nextZ >= gridSize ||
+                nextSection < 0 || nextSection >= Geometry::SECTION_COUNT) {
+                continue;
+            }
+
+            // A section is expanded once per face it is entered through, so an early arrival
+            // from one side never hides the paths that only continue from another
+            int nextColumn = columnIndex(nextX, nextZ);
+            uint8_t enteredFrom = static_cast<uint8_t>(oppositeFace(face));
+            uint8_t& entered = enteredFaces[nextColumn * Geometry::SECTION_COUNT + nextSection];
+            if (entered & (1u << enteredFrom)) continue;
+
+            glm::vec3 sectionMin(static_cast<float>((gridOrigin.x + nextX) * CHUNK_WIDTH),
+                                 static_cast<float>(nextSection * Geometry::SECTION_HEIGHT),
+                                 static_cast<float>((gridOrigin.z + nextZ) * CHUNK_DEPTH));
+            if (!frustum.containsAABB(sectionMin, sectionMin + sectionSize)) continue;
+
+            entered |= static_cast<uint8_t>(1u << enteredFrom);
+            reached[nextColumn].set(nextSection);
+            queue.push_back(Node{nextX, nextZ, nextSection, enteredFrom,
+                                 static_cast<uint8_t>(node.directions | (1u << face))});
+        }
+    }
+
+    visitedSections = static_cast<int>(queue.size());
+}
+
+bool CaveCuller::isSectionVisible(ChunkCoord coord, int section) const {
+    int gridX = coord.x - gridOrigin.x;
+    int gridZ = coord.z - gridOrigin.z;
+    if (!active || gridX < 0 || gridX >= gridSize || gridZ < 0 || gridZ >= gridSize) {
+        return true;  // Outside the search - no evidence either way
+    }
+    return reached[columnIndex(gridX, gridZ)].test(section);
+}
+
+bool CaveCuller::isChunkVisible(ChunkCoord coord) const {
+    int gridX = coord.x - gridOrigin.x;
+    int gridZ = coord.z - gridOrigin.z;
+    if (!active || gridX < 0 || gridX >= gridSize || gridZ < 0 || gridZ >= gridSize) {
+        return true;
+    }
+    return reached[columnIndex(gridX, gridZ)].any();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "chunk.h"
+#include "../utils/math_utils.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @file cave_culler.h
+ * @brief Section-level visibility search through the face connectivity of chunk sections
+ *
+ * Every section records which pairs of its six faces are joined through non-opaque blocks
+ * (Chunk::computeSectionConnectivity). Each frame a breadth-first search starts at the camera's
+ * section and steps into a neighbour only when:
+ *  - the face it entered the current section through connects to the face it leaves by,
+ *  - the step does not turn back against a direction already taken on the path, and
+ *  - the neighbour section's box is inside the view frustum.
+ * Sections the search never reaches - underground pockets behind solid rock - cannot be seen.
+ *
+ * Sections outside the meshed window, and positions with no loaded chunk, have no geometry
+ * to block the view and are treated as open. The search only reads connectivity masks through
+ * a lookup callback and never touches Chunk objects or GL, so it can run over hand-built worlds.
+ */
+class CaveCuller {
+public:
+    // SECTION_COUNT connectivity masks for the column at a chunk coordinate, or nullptr when
+    // no chunk is loaded there; the pointer must stay valid until update() returns
+    using ConnectivityLookup = std::function<const uint16_t*(ChunkCoord)>;
+
+    // Search from the camera across chunks within radius (Chebyshev) of the camera's chunk
+    // With the camera above or below the world every section counts as visible
+    void update(const glm::vec3& cameraPos, const MathUtils::Frustum& frustum, int radius,
+                int minSection, int maxSection, const ConnectivityLookup& getConnectivity);
+
+    bool isSectionVisible(ChunkCoord coord, int section) const;
+    // A chunk column is visible if any of its sections is
+    bool isChunkVisible(ChunkCoord coord) const;
+
+    // False when the last update left everything visible (camera outside the world)
+    bool isActive() const { return active; }
+    int getVisitedSectionCount() const { return visitedSections; }
+
+private:
+    struct Node {
+        int gridX, gridZ, section;
+        uint8_t enteredFrom;    // Face of this section the search came through (6 = start)
+        uint8_t directions;     // Bit per face direction already stepped along on the path
+    };
+
+    bool active = false;
+    int radius = 0;
+    int gridSize = 0;
+    ChunkCoord gridOrigin;
+    int visitedSections = 0;
+
+    // Reused across frames; indexed by grid column (z * gridSize + x)
+    std::vector<const uint16_t*> columns;
+    std::vector<std::bitset<CurrentChunkGeometry::SECTION_COUNT>> reached;
+    std::vector<uint8_t> enteredFaces;      // Per section: faces it was already entered through
+    std::vector<Node> queue;
+
+    int columnIndex(int gridX, int gridZ) const { return gridZ * gridSize + gridX; }
+};
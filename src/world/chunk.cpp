@@ -1,12 +1,20 @@
 #include "chunk.h"
 #include "world.h"
 #include "block.h"
+#include "block_cursor.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <atomic>
+#include <mutex>
 
 // Global flag to reset static noise generators when seed changes
-bool g_resetChunkNoise = false;
+std::atomic<bool> g_resetChunkNoise(false);
+
+// Vertex scratch reused by every generateMesh() call (meshing runs on the GL thread only)
+static std::vector<float> meshScratch;
+// Flood-fill stack for updateSectionConnectivity(), same thread and lifetime as meshScratch
+static std::vector<int> connectivityStack;
 
 // Face vertices for cube mesh generation (in local coordinates)
 // All faces ordered counter-clockwise when viewed from outside the cube
@@ -60,25 +68,55 @@ const std::array<glm::vec3, 6> Chunk::FACE_NORMALS = {{
 }};
 
 Chunk::Chunk(ChunkCoord coord, World* world)
-    : coord(coord), state(ChunkState::EMPTY), world(world), VAO(0), VBO(0),
-      vertexCount(0), meshDirty(true), hasGeometry(false), hadAllNeighbors(false), lastNeighborCheck(0.0f) {
+    : coord(coord), state(ChunkState::EMPTY), meshMinSection(0),
+      meshMaxSection(CurrentChunkGeometry::SECTION_COUNT - 1), lodLevel(0), world(world), VAO(0), VBO(0), bufferCapacity(0),
+      vertexCount(0), opaqueVertexCount(0), meshDirty(true), hasGeometry(false), meshMinY(0), meshMaxY(0), modified(false), hadAllNeighbors(false), lastNeighborCheck(0.0f) {
 
     // Initialize all blocks to air
     blocks.fill(BlockData(BlockType::AIR));
+    sectionBlockCounts.fill(0);
+    occluderHeights.fill(0);
+    sectionConnectivity.fill(ALL_FACES_CONNECTED);
 
     // Initialize neighbor tracking
     for (int i = 0; i < 4; i++) {
         neighborsAvailable[i] = false;
     }
 
-    // Initialize OpenGL resources
-    initializeGL();
+    // OpenGL resources are created with the first non-empty mesh, so block data alone can be
+    // built and queried without a context
 }
 
 Chunk::~Chunk() {
     cleanupGL();
 }
 
+void Chunk::reset(ChunkCoord newCoord) {
+    coord = newCoord;
+    state = ChunkState::EMPTY;
+    lodLevel = 0;
+    vertexCount = 0;
+    opaqueVertexCount = 0;
+    hasGeometry = false;
+    meshMinY = 0;
+    meshMaxY = 0;
+    meshedSections.reset();
+    occluderHeights.fill(0);
+    sectionConnectivity.fill(ALL_FACES_CONNECTED);
+    meshDirty = true;
+    modified = false;
+
+    for (int i = 0; i < 4; i++) {
+        neighborsAvailable[i] = false;
+    }
+    hadAllNeighbors = false;
+    lastNeighborCheck = 0.0f;
+}
+
+size_t Chunk::getMeshScratchBytes() {
+    return meshScratch.capacity() * sizeof(float);
+}
+
 BlockData Chunk::getBlock(int x, int y, int z) const {
     if (!isInBounds(x, y, z)) {
         return BlockData(BlockType::AIR);
@@ -93,11 +131,71 @@ void Chunk::setBlock(int x, int y, int z, BlockData block) {
 
     int index = getBlockIndex(x, y, z);
     if (blocks[index] != block) {
+        bool wasAir = blocks[index].type == BlockType::AIR;
+        bool isAir = block.type == BlockType::AIR;
+        if (wasAir != isAir) {
+            sectionBlockCounts[CurrentChunkGeometry::sectionOf(y)] += isAir ? -1 : 1;
+        }
+
         blocks[index] = block;
         markForRemesh();
     }
 }
 
+void Chunk::recountSections() {
+    recountSections(0, CurrentChunkGeometry::SECTION_COUNT - 1);
+}
+
+void Chunk::recountSections(int firstSection, int lastSection) {
+    for (int section = firstSection; section <= lastSection; section++) {
+        // Sections are contiguous in y-major storage
+        const BlockData* begin = blocks.data() + section * CurrentChunkGeometry::SECTION_VOLUME;
+        const BlockData* end = begin + CurrentChunkGeometry::SECTION_VOLUME;
+        sectionBlockCounts[section] = static_cast<uint16_t>(std::count_if(begin, end, [](const BlockData& block) {
+            return block.type != BlockType::AIR;
+        }));
+    }
+}
+
+void Chunk::setMeshSectionRange(int minSection, int maxSection) {
+    minSection = std::max(minSection, 0);
+    maxSection = std::min(maxSection, CurrentChunkGeometry::SECTION_COUNT - 1);
+    if (minSection == meshMinSection && maxSection == meshMaxSection) {
+        return;
+    }
+
+    // Empty sections produce no faces, so moving the window across open sky costs nothing
+    for (int section = 0; section < CurrentChunkGeometry::SECTION_COUNT; section++) {
+        bool wasMeshed = section >= meshMinSection && section <= meshMaxSection;
+        bool isMeshed = section >= minSection && section <= maxSection;
+        if (wasMeshed != isMeshed && sectionBlockCounts[section] != 0) {
+            markForRemesh();
+            break;
+        }
+    }
+
+    meshMinSection = minSection;
+    meshMaxSection = maxSection;
+}
+
+bool Chunk::setLodLevel(int level) {
+    level = std::max(0, std::min(MAX_LOD_LEVEL, level));
+    if (level == lodLevel) {
+        return false;
+    }
+    lodLevel = level;
+    markForRemesh();
+    return true;
+}
+
+BlockType Chunk::getMeshedBlockType(int x, int y, int z) const {
+    if (lodLevel == 0) {
+        return getBlock(x, y, z).type;
+    }
+    int cellMask = ~((1 << lodLevel) - 1);
+    return voteCell(1 << lodLevel, x & cellMask, y & cellMask, z & cellMask);
+}
+
 BlockData Chunk::getBlockSafe(int x, int y, int z) const {
     return getBlock(x, y, z);
 }
@@ -107,13 +205,11 @@ void Chunk::setBlockSafe(int x, int y, int z, BlockData block) {
 }
 
 BlockData Chunk::getBlockWorld(int worldX, int worldY, int worldZ) const {
-    glm::ivec3 local = ChunkUtils::worldToLocal(worldX, worldY, worldZ);
-    return getBlock(local.x, local.y, local.z);
+    return getBlock(CurrentChunkGeometry::worldToLocalX(worldX), worldY, CurrentChunkGeometry::worldToLocalZ(worldZ));
 }
 
 void Chunk::setBlockWorld(int worldX, int worldY, int worldZ, BlockData block) {
-    glm::ivec3 local = ChunkUtils::worldToLocal(worldX, worldY, worldZ);
-    setBlock(local.x, local.y, local.z, block);
+    setBlock(CurrentChunkGeometry::worldToLocalX(worldX), worldY, CurrentChunkGeometry::worldToLocalZ(worldZ), block);
 }
 
 void Chunk::generateMesh() {
@@ -126,105 +222,377 @@ void Chunk::generateMesh() {
         return;
     }    setState(ChunkState::MESHING);
 
-    std::vector<float> vertices;
-    vertices.reserve(MAX_VERTICES_PER_CHUNK * VERTEX_STRIDE);
+    // The shared scratch keeps its capacity, so steady-state meshing does not allocate
+    std::vector<float>& vertices = meshScratch;
+    vertices.clear();
 
-    // First pass: Render solid blocks for proper depth testing
-    for (int y = 0; y < CHUNK_HEIGHT; y++) {
-        for (int z = 0; z < CHUNK_DEPTH; z++) {
-            for (int x = 0; x < CHUNK_WIDTH; x++) {
-                BlockData blockData = getBlock(x, y, z);
+    // addFace() widens these to the blocks that actually produce faces
+    meshMinY = CHUNK_HEIGHT;
+    meshMaxY = 0;
+    meshedSections.reset();
 
-                // Skip air blocks
-                if (blockData.type == BlockType::AIR) {
-                    continue;
-                }
+    if (lodLevel > 0) {
+        generateLodMesh(vertices);
+    }
 
-                const Block& block = BlockRegistry::getBlock(blockData.type);
+    // First pass: Render solid blocks for proper depth testing (full resolution only)
+    for (int section = meshMinSection; lodLevel == 0 && section <= meshMaxSection; section++) {
+        if (sectionBlockCounts[section] == 0) {
+            continue;  // Nothing to mesh in an all-air section
+        }
+        int sectionBottom = section << CurrentChunkGeometry::SECTION_SHIFT;
+        int sectionTop = sectionBottom + CurrentChunkGeometry::SECTION_HEIGHT;
+        for (int y = sectionBottom; y < sectionTop; y++) {
+            for (int z = 0; z < CHUNK_DEPTH; z++) {
+                for (int x = 0; x < CHUNK_WIDTH; x++) {
+                    BlockData blockData = getBlock(x, y, z);
+
+                    // Skip air blocks
+                    if (blockData.type == BlockType::AIR) {
+                        continue;
+                    }
 
-                // FIRST PASS: Only render solid, opaque blocks
-                if (!block.isSolid || block.isTransparent) {
-                    continue;
-                }
+                    const Block& block = BlockRegistry::getBlock(blockData.type);
 
-                glm::vec3 blockPos(x, y, z);
+                    // FIRST PASS: Only render solid, opaque blocks
+                    if (!block.isSolid || block.isTransparent) {
+                        continue;
+                    }
+
+                    glm::vec3 blockPos(x, y, z);
 
-                // Check each face for visibility
-                for (int face = 0; face < 6; face++) {
-                    if (shouldRenderFace(x, y, z, static_cast<CubeFace>(face))) {
-                        addFace(vertices, blockPos, static_cast<CubeFace>(face), blockData.type);
+                    // Check each face for visibility
+                    for (int face = 0; face < 6; face++) {
+                        if (shouldRenderFace(x, y, z, static_cast<CubeFace>(face))) {
+                            addFace(vertices, blockPos, static_cast<CubeFace>(face), blockData.type);
+                        }
                     }
                 }
             }
         }
     }
 
-    // SECOND PASS: Render transparent blocks last for proper blending
-    for (int y = 0; y < CHUNK_HEIGHT; y++) {
-        for (int z = 0; z < CHUNK_DEPTH; z++) {
-            for (int x = 0; x < CHUNK_WIDTH; x++) {
-                BlockData blockData = getBlock(x, y, z);
-
-                // Skip air blocks
-                if (blockData.type == BlockType::AIR) {
-                    continue;
-                }
-
-                const Block& block = BlockRegistry::getBlock(blockData.type);                // SECOND PASS: Only render transparent blocks
-                if (!block.isTransparent) {
-                    continue;
-                }
+    if (lodLevel == 0) {
+        opaqueVertexCount = vertices.size() / VERTEX_STRIDE;
+    }
 
-                glm::vec3 blockPos(x, y, z);
+    // SECOND PASS: Render transparent blocks last for proper blending
+    for (int section = meshMinSection; lodLevel == 0 && section <= meshMaxSection; section++) {
+        if (sectionBlockCounts[section] == 0) {
+            continue;  // Nothing to mesh in an all-air section
+        }
+        int sectionBottom = section << CurrentChunkGeometry::SECTION_SHIFT;
+        int sectionTop = sectionBottom + CurrentChunkGeometry::SECTION_HEIGHT;
+        for (int y = sectionBottom; y < sectionTop; y++) {
+            for (int z = 0; z < CHUNK_DEPTH; z++) {
+                for (int x = 0; x < CHUNK_WIDTH; x++) {
+                    BlockData blockData = getBlock(x, y, z);
+
+                    // Skip air blocks
+                    if (blockData.type == BlockType::AIR) {
+                        continue;
+                    }
 
-                // Check each face for visibility - use water-specific culling for water blocks
-                for (int face = 0; face < 6; face++) {
-                    bool shouldRender;
-                    if (blockData.type == BlockType::WATER) {
-                        // Use water-specific face culling to prevent holes at chunk boundaries
-                        shouldRender = shouldRenderWaterFace(x, y, z, static_cast<CubeFace>(face));
-                    } else {
-                        // Use normal face culling for other transparent blocks
-                        shouldRender = shouldRenderFace(x, y, z, static_cast<CubeFace>(face));
+                    const Block& block = BlockRegistry::getBlock(blockData.type);                // SECOND PASS: Only render transparent blocks
+                    if (!block.isTransparent) {
+                        continue;
                     }
 
-                    if (shouldRender) {
-                        addFace(vertices, blockPos, static_cast<CubeFace>(face), blockData.type);
+                    glm::vec3 blockPos(x, y, z);
+
+                    // Check each face for visibility - use water-specific culling for water blocks
+                    for (int face = 0; face < 6; face++) {
+                        bool shouldRender;
+                        if (blockData.type == BlockType::WATER) {
+                            // Use water-specific face culling to prevent holes at chunk boundaries
+                            shouldRender = shouldRenderWaterFace(x, y, z, static_cast<CubeFace>(face));
+                        } else {
+                            // Use normal face culling for other transparent blocks
+                            shouldRender = shouldRenderFace(x, y, z, static_cast<CubeFace>(face));
+                        }
+
+                        if (shouldRender) {
+                            addFace(vertices, blockPos, static_cast<CubeFace>(face), blockData.type);
+                        }
                     }
                 }
             }
         }
     }
 
+    updateOccluderHeights();
+    updateSectionConnectivity();
+
     // Update OpenGL buffers
-    vertexCount = vertices.size() / 8; // 8 floats per vertex (pos3 + normal3 + uv2)
+    vertexCount = vertices.size() / VERTEX_STRIDE;
     hasGeometry = vertexCount > 0;
+    if (!hasGeometry) {
+        meshMinY = 0;
+        meshMaxY = 0;
+    }
 
     if (hasGeometry) {
+        if (VAO == 0) {
+            initializeGL();
+        }
         glBindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
-                     vertices.data(), GL_STATIC_DRAW);
 
-        // Position attribute (location 0)
+        // Reuse the buffer's storage when the mesh fits; reallocate when it grows, or when it
+        // shrank to a fraction of the buffer (e.g. the vertical window moved) to give memory back
+        size_t meshBytes = vertices.size() * sizeof(float);
+        if (meshBytes > bufferCapacity || meshBytes < bufferCapacity / 4) {
+            glBufferData(GL_ARRAY_BUFFER, meshBytes, vertices.data(), GL_STATIC_DRAW);
+            bufferCapacity = meshBytes;
+        } else {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, meshBytes, vertices.data());
+        }
+
+        // Position attribute (location 0), in block units relative to the chunk
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_STRIDE * sizeof(float), (void*)0);
 
-        // Normal attribute (location 1)
+        // Face ID attribute (location 1)
         glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, VERTEX_STRIDE * sizeof(float),
                               (void*)(3 * sizeof(float)));
 
         // Texture coordinate attribute (location 2)
         glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
-                              (void*)(6 * sizeof(float)));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_STRIDE * sizeof(float),
+                              (void*)(4 * sizeof(float)));
 
         glBindVertexArray(0);    }    meshDirty = false;
     setState(ChunkState::READY);
 }
 
-void Chunk::render(const glm::mat4& /* view */, const glm::mat4& /* projection */, const glm::vec3& cameraPos) {
+void Chunk::updateOccluderHeights() {
+    for (int cellZ = 0; cellZ < OCCLUDER_CELLS_Z; cellZ++) {
+        for (int cellX = 0; cellX < OCCLUDER_CELLS_X; cellX++) {
+            // Each column only needs scanning up to the lowest run found so far in the cell
+            int cellHeight = CHUNK_HEIGHT;
+            for (int z = cellZ * OCCLUDER_CELL; z < (cellZ + 1) * OCCLUDER_CELL; z++) {
+                for (int x = cellX * OCCLUDER_CELL; x < (cellX + 1) * OCCLUDER_CELL; x++) {
+                    int y = 0;
+                    while (y < cellHeight) {
+                        const Block& block = BlockRegistry::getBlock(getBlock(x, y, z).type);
+                        if (!block.isSolid || block.isTransparent) break;
+                        y++;
+                    }
+                    cellHeight = y;
+                }
+            }
+            occluderHeights[cellZ * OCCLUDER_CELLS_X + cellX] = static_cast<uint16_t>(cellHeight);
+        }
+    }
+}
+
+void Chunk::updateSectionConnectivity() {
+    using Geometry = CurrentChunkGeometry;
+
+    // Voted LOD cells can open gaps the blocks do not have, so LOD meshes never block the search
+    if (lodLevel > 0) {
+        sectionConnectivity.fill(ALL_FACES_CONNECTED);
+        return;
+    }
+
+    OpacityTable opaque;
+    for (size_t type = 0; type < opaque.size(); type++) {
+        const Block& block = BlockRegistry::getBlock(static_cast<BlockType>(type));
+        opaque[type] = block.isSolid && !block.isTransparent;
+    }
+
+    for (int section = 0; section < Geometry::SECTION_COUNT; section++) {
+        sectionConnectivity[section] = sectionBlockCounts[section] == 0
+            ? ALL_FACES_CONNECTED
+            : computeSectionConnectivity(&blocks[section * Geometry::SECTION_VOLUME], opaque, connectivityStack);
+    }
+}
+
+uint16_t Chunk::computeSectionConnectivity(const BlockData* sectionBlocks, const OpacityTable& opaque,
+                                           std::vector<int>& stack) {
+    using Geometry = CurrentChunkGeometry;
+    const int layer = 1 << Geometry::LAYER_SHIFT;
+
+    std::bitset<Geometry::SECTION_VOLUME> visited;
+    // Each block is pushed at most once, so one reserve covers every later call
+    stack.clear();
+    stack.reserve(Geometry::SECTION_VOLUME);
+
+    // Flood-fill each connected region of non-opaque blocks (the section is one contiguous
+    // run of y-major storage) and join every pair of faces the region touches
+    uint16_t connectivity = 0;
+    for (int start = 0; start < Geometry::SECTION_VOLUME; start++) {
+        if (visited[start] || opaque[static_cast<size_t>(sectionBlocks[start].type)]) continue;
+
+        unsigned faces = 0;
+        visited[start] = true;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int index = stack.back();
+            stack.pop_back();
+            int x = index & (CHUNK_WIDTH - 1);
+            int z = (index >> Geometry::WIDTH_SHIFT) & (CHUNK_DEPTH - 1);
+            int y = index >> Geometry::LAYER_SHIFT;
+
+            int neighbors[6];
+            int neighborCount = 0;
+            if (x > 0) neighbors[neighborCount++] = index - 1; else faces |= 1u << static_cast<int>(CubeFace::LEFT);
+            if (x < CHUNK_WIDTH - 1) neighbors[neighborCount++] = index + 1; else faces |= 1u << static_cast<int>(CubeFace::RIGHT);
+            if (z > 0) neighbors[neighborCount++] = index - CHUNK_WIDTH; else faces |= 1u << static_cast<int>(CubeFace::BACK);
+            if (z < CHUNK_DEPTH - 1) neighbors[neighborCount++] = index + CHUNK_WIDTH; else faces |= 1u << static_cast<int>(CubeFace::FRONT);
+            if (y > 0) neighbors[neighborCount++] = index - layer; else faces |= 1u << static_cast<int>(CubeFace::BOTTOM);
+            if (y < Geometry::SECTION_HEIGHT - 1) neighbors[neighborCount++] = index + layer; else faces |= 1u << static_cast<int>(CubeFace::TOP);
+
+            for (int i = 0; i < neighborCount; i++) {
+                int next = neighbors[i];
+                if (!visited[next] && !opaque[static_cast<size_t>(sectionBlocks[next].type)]) {
+                    visited[next] = true;
+                    stack.push_back(next);
+                }
+            }
+        }
+
+        for (int a = 0; a < 6; a++) {
+            for (int b = a + 1; b < 6; b++) {
+                if ((faces >> a & 1u) && (faces >> b & 1u)) {
+                    connectivity |= facePairBit(static_cast<CubeFace>(a), static_cast<CubeFace>(b));
+                }
+            }
+        }
+        if (connectivity == ALL_FACES_CONNECTED) break;
+    }
+    return connectivity;
+}
+
+BlockType Chunk::voteCell(int size, int x0, int y0, int z0) const {
+    std::array<uint16_t, static_cast<size_t>(BlockType::COUNT)> counts{};
+    int solidCount = 0;
+    for (int y = y0; y < y0 + size; y++) {
+        for (int z = z0; z < z0 + size; z++) {
+            for (int x = x0; x < x0 + size; x++) {
+                BlockType type = blocks[CurrentChunkGeometry::blockIndex(x, y, z)].type;
+                if (type != BlockType::AIR) {
+                    counts[static_cast<size_t>(type)]++;
+                    solidCount++;
+                }
+            }
+        }
+    }
+
+    // The cell is filled only if most of its blocks are, with the most common type
+    if (solidCount * 2 <= size * size * size) {
+        return BlockType::AIR;
+    }
+    size_t winner = 0;
+    for (size_t type = 1; type < counts.size(); type++) {
+        if (counts[type] > counts[winner]) winner = type;
+    }
+    return static_cast<BlockType>(winner);
+}
+
+bool Chunk::shouldRenderLodFace(int size, int x0, int y0, int z0, CubeFace face, const Block& block) const {
+    glm::ivec3 normal(FACE_NORMALS[static_cast<int>(face)]);
+    int x = x0 + normal.x * size;
+    int y = y0 + normal.y * size;
+    int z = z0 + normal.z * size;
+    if (y < 0) return false;
+    if (y >= CHUNK_HEIGHT) return true;
+    if (x >= 0 && x < CHUNK_WIDTH && z >= 0 && z < CHUNK_DEPTH) {
+        return block.shouldRenderFace(voteCell(size, x, y, z));
+    }
+
+    // Across the border, compare against the neighbour as its own mesh shows it - its cells
+    // may be finer than ours, so sample the face at its resolution
+    const Chunk* neighbor = world ? world->getChunk(ChunkCoord(coord.x + normal.x, coord.z + normal.z)) : nullptr;
+    if (!neighbor) {
+        return true;
+    }
+    int localX = x & (CHUNK_WIDTH - 1);
+    int localZ = z & (CHUNK_DEPTH - 1);
+    int step = std::min(size, 1 << neighbor->getLodLevel());
+    int spanX = normal.x == 0 ? size : 1;
+    int spanZ = normal.z == 0 ? size : 1;
+    for (int dy = 0; dy < size; dy += step) {
+        for (int dz = 0; dz < spanZ; dz += step) {
+            for (int dx = 0; dx < spanX; dx += step) {
+                if (block.shouldRenderFace(neighbor->getMeshedBlockType(localX + dx, y + dy, localZ + dz))) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void Chunk::generateLodMesh(std::vector<float>& vertices) {
+    const int size = 1 << lodLevel;
+    const glm::vec3 cellSize(static_cast<float>(size));
+    static const CubeFace SIDE_FACES[4] = {CubeFace::LEFT, CubeFace::RIGHT, CubeFace::BACK, CubeFace::FRONT};
+
+    // Opaque cells first, then transparent ones, matching the full-resolution pass order
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            opaqueVertexCount = vertices.size() / VERTEX_STRIDE;
+        }
+        for (int section = meshMinSection; section <= meshMaxSection; section++) {
+            if (sectionBlockCounts[section] == 0) {
+                continue;
+            }
+            int sectionBottom = section << CurrentChunkGeometry::SECTION_SHIFT;
+            int sectionTop = sectionBottom + CurrentChunkGeometry::SECTION_HEIGHT;
+            for (int y = sectionBottom; y < sectionTop; y += size) {
+                for (int z = 0; z < CHUNK_DEPTH; z += size) {
+                    for (int x = 0; x < CHUNK_WIDTH; x += size) {
+                        BlockType type = voteCell(size, x, y, z);
+                        if (type == BlockType::AIR) {
+                            continue;
+                        }
+                        const Block& block = BlockRegistry::getBlock(type);
+                        bool opaque = block.isSolid && !block.isTransparent;
+                        if (opaque != (pass == 0)) {
+                            continue;
+                        }
+
+                        glm::vec3 cellPos(x, y, z);
+                        bool skirted = opaque && shouldRenderLodFace(size, x, y, z, CubeFace::TOP, block);
+                        for (int face = 0; face < 6; face++) {
+                            CubeFace cubeFace = static_cast<CubeFace>(face);
+                            glm::ivec3 normal(FACE_NORMALS[face]);
+                            bool borderFace = (normal.x < 0 && x == 0) || (normal.x > 0 && x + size == CHUNK_WIDTH) ||
+                                              (normal.z < 0 && z == 0) || (normal.z > 0 && z + size == CHUNK_DEPTH);
+                            if (skirted && borderFace) {
+                                continue;  // Replaced by the skirt below
+                            }
+                            if (shouldRenderLodFace(size, x, y, z, cubeFace, block)) {
+                                addFace(vertices, cellPos, cubeFace, type, cellSize);
+                            }
+                        }
+
+                        // Skirts: surface cells on the chunk border always draw their outer side,
+                        // extended one cell down, so seams against a neighbour at another level
+                        // (or T-junctions along the shared edge) show terrain instead of sky
+                        if (!skirted) {
+                            continue;
+                        }
+                        int skirtBottom = std::max(0, y - size);
+                        glm::vec3 skirtPos(x, skirtBottom, z);
+                        glm::vec3 skirtSize(size, y + size - skirtBottom, size);
+                        for (CubeFace side : SIDE_FACES) {
+                            glm::ivec3 normal(FACE_NORMALS[static_cast<int>(side)]);
+                            if ((normal.x < 0 && x == 0) || (normal.x > 0 && x + size == CHUNK_WIDTH) ||
+                                (normal.z < 0 && z == 0) || (normal.z > 0 && z + size == CHUNK_DEPTH)) {
+                                addFace(vertices, skirtPos, side, type, skirtSize);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Chunk::submitDraw(RenderQueue& queue, const RenderQueue::DrawState& state, const glm::vec3& cameraPos) const {
     if (!isReady() || !hasGeometry) {
         return;
     }// Distance-based culling for performance
@@ -246,12 +614,17 @@ void Chunk::render(const glm::mat4& /* view */, const glm::mat4& /* projection *
         return;
     }
 
-    // TODO: Shader management should be handled by a renderer class
-    // For now, assume shader is bound externally
-
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
-    glBindVertexArray(0);
+    // Opaque faces sort front to back with every other opaque draw; water and leaves sort
+    // back to front after all of them
+    glm::ivec2 origin(coord.x * CHUNK_WIDTH, coord.z * CHUNK_DEPTH);
+    RenderQueue::DrawState opaqueState = state;
+    opaqueState.blend = false;
+    queue.submit(opaqueState, VAO, 0, static_cast<GLsizei>(opaqueVertexCount), origin, distance);
+
+    RenderQueue::DrawState translucentState = state;
+    translucentState.blend = true;
+    queue.submit(translucentState, VAO, static_cast<GLint>(opaqueVertexCount),
+                 static_cast<GLsizei>(vertexCount - opaqueVertexCount), origin, distance);
 }
 
 void Chunk::clearMesh() {
@@ -262,7 +635,13 @@ void Chunk::clearMesh() {
     }
 
     vertexCount = 0;
+    opaqueVertexCount = 0;
     hasGeometry = false;
+    meshMinY = 0;
+    meshMaxY = 0;
+    meshedSections.reset();
+    occluderHeights.fill(0);
+    sectionConnectivity.fill(ALL_FACES_CONNECTED);
     meshDirty = true;
 }
 
@@ -271,9 +650,7 @@ glm::vec3 Chunk::getWorldPosition() const {
 }
 
 bool Chunk::isInBounds(int x, int y, int z) const {
-    return x >= 0 && x < CHUNK_WIDTH &&
-           y >= 0 && y < CHUNK_HEIGHT &&
-           z >= 0 && z < CHUNK_DEPTH;
+    return CurrentChunkGeometry::isInBounds(x, y, z);
 }
 
 bool Chunk::shouldRenderFace(int x, int y, int z, CubeFace face) const {
@@ -300,31 +677,21 @@ bool Chunk::shouldRenderFace(int x, int y, int z, CubeFace face) const {
         return current.shouldRenderFace(adjacentBlock.type);
     }    // At chunk boundary - check neighboring chunks through World
     if (world) {
-        // Convert current block position to world coordinates
+        // One chunk lookup resolves both "is the neighbor loaded" and the adjacent block
         glm::vec3 chunkWorldPos = getWorldPosition();
-        glm::ivec3 currentBlockWorldPos(
-            static_cast<int>(chunkWorldPos.x) + x,  // x is the local block coordinate (0-15)
-            y,
-            static_cast<int>(chunkWorldPos.z) + z   // z is the local block coordinate (0-15)
-        );
-
-        // Calculate adjacent block world position by applying face offset
-        glm::ivec3 worldAdjacentPos = currentBlockWorldPos;
-        switch (face) {
-            case CubeFace::FRONT:  worldAdjacentPos.z += 1; break;
-            case CubeFace::BACK:   worldAdjacentPos.z -= 1; break;
-            case CubeFace::LEFT:   worldAdjacentPos.x -= 1; break;
-            case CubeFace::RIGHT:  worldAdjacentPos.x += 1; break;
-            case CubeFace::TOP:    worldAdjacentPos.y += 1; break;
-            case CubeFace::BOTTOM: worldAdjacentPos.y -= 1; break;
-        }
-
-        // Check if the neighboring chunk exists
-        ChunkCoord neighborChunkCoord = ChunkUtils::worldToChunkCoord(worldAdjacentPos.x, worldAdjacentPos.z);
-        const Chunk* neighborChunk = world->getChunk(neighborChunkCoord);        if (neighborChunk) {
-            // Neighboring chunk exists, get the actual adjacent block
-            BlockData adjacentBlock = world->getBlock(worldAdjacentPos.x, worldAdjacentPos.y, worldAdjacentPos.z);
-            return current.shouldRenderFace(adjacentBlock.type);
+        BlockCursor neighbor(world, static_cast<int>(chunkWorldPos.x) + x, y, static_cast<int>(chunkWorldPos.z) + z);
+        neighbor.step(face);
+
+        if (neighbor.isLoaded()) {
+            // Neighboring chunk exists - compare against the block as its mesh shows it, so a
+            // coarser LOD neighbour does not leave holes where its cells are lower than ours
+            const Chunk* neighborChunk = neighbor.getChunk();
+            if (neighborChunk->getLodLevel() > 0 && y >= 0 && y < CHUNK_HEIGHT) {
+                glm::ivec3 neighborPos = neighbor.getPosition();
+                return current.shouldRenderFace(neighborChunk->getMeshedBlockType(
+                    CurrentChunkGeometry::worldToLocalX(neighborPos.x), y, CurrentChunkGeometry::worldToLocalZ(neighborPos.z)));
+            }
+            return current.shouldRenderFace(neighbor.get().type);
         } else {
             // Neighboring chunk doesn't exist yet - use smarter assumptions
             // For water blocks specifically, we need to be more careful about face culling
@@ -364,10 +731,18 @@ bool Chunk::shouldRenderFace(int x, int y, int z, CubeFace face) const {
 }
 
 void Chunk::addFace(std::vector<float>& vertices, const glm::vec3& pos,
-                    CubeFace face, BlockType blockType) {
+                    CubeFace face, BlockType blockType, const glm::vec3& size) {
+    int y = static_cast<int>(pos.y);
+    int top = y + static_cast<int>(size.y);
+    meshMinY = std::min(meshMinY, y);
+    meshMaxY = std::max(meshMaxY, top);
+    for (int section = CurrentChunkGeometry::sectionOf(y); section <= CurrentChunkGeometry::sectionOf(top - 1); section++) {
+        meshedSections.set(section);
+    }
 
     const auto& faceVertices = FACE_VERTICES[static_cast<int>(face)];
-    const glm::vec3& normal = FACE_NORMALS[static_cast<int>(face)];
+    // The face ID is small enough to be exact as a float; block.vert maps it to a normal
+    const float faceId = static_cast<float>(face);
 
     // Get texture coordinates for this block type
     const Block& block = BlockRegistry::getBlock(blockType);
@@ -392,16 +767,15 @@ void Chunk::addFace(std::vector<float>& vertices, const glm::vec3& pos,
     // Create two triangles for the face (quad split)
     // Triangle 1: 0, 1, 2
     for (int i : {0, 1, 2}) {
-        glm::vec3 worldPos = pos + faceVertices[i];
+        glm::vec3 worldPos = pos + faceVertices[i] * size;
 
         // Position
         vertices.push_back(worldPos.x);
         vertices.push_back(worldPos.y);
         vertices.push_back(worldPos.z);
 
-        // Normal
-        vertices.push_back(normal.x);
-        vertices.push_back(normal.y);        vertices.push_back(normal.z);
+        // Face ID
+        vertices.push_back(faceId);
 
         // Texture coordinates (normal U, V)
         vertices.push_back(uvCoords[i].x);
@@ -410,17 +784,15 @@ void Chunk::addFace(std::vector<float>& vertices, const glm::vec3& pos,
 
     // Triangle 2: 0, 2, 3
     for (int i : {0, 2, 3}) {
-        glm::vec3 worldPos = pos + faceVertices[i];
+        glm::vec3 worldPos = pos + faceVertices[i] * size;
 
         // Position
         vertices.push_back(worldPos.x);
         vertices.push_back(worldPos.y);
         vertices.push_back(worldPos.z);
 
-        // Normal
-        vertices.push_back(normal.x);
-        vertices.push_back(normal.y);
-        vertices.push_back(normal.z);
+        // Face ID
+        vertices.push_back(faceId);
 
         // Texture coordinates (normal U, V)
         vertices.push_back(uvCoords[i].x);
@@ -437,14 +809,12 @@ void Chunk::addQuadVertices(std::vector<float>& /* vertices */,
 }
 
 int Chunk::getBlockIndex(int x, int y, int z) const {
-    return y * CHUNK_WIDTH * CHUNK_DEPTH + z * CHUNK_WIDTH + x;
+    return CurrentChunkGeometry::blockIndex(x, y, z);
 }
 
 glm::vec3 Chunk::indexToLocal(int index) const {
-    int x = index % CHUNK_WIDTH;
-    int z = (index / CHUNK_WIDTH) % CHUNK_DEPTH;
-    int y = index / (CHUNK_WIDTH * CHUNK_DEPTH);
-    return glm::vec3(x, y, z);
+    return glm::vec3(CurrentChunkGeometry::indexToX(index), CurrentChunkGeometry::indexToY(index),
+                     CurrentChunkGeometry::indexToZ(index));
 }
 
 glm::vec3 Chunk::localToWorld(int x, int y, int z) const {
@@ -461,6 +831,7 @@ void Chunk::cleanupGL() {
     if (VBO != 0) {
         glDeleteBuffers(1, &VBO);
         VBO = 0;
+        bufferCapacity = 0;
     }
 
     if (VAO != 0) {
@@ -472,30 +843,11 @@ void Chunk::cleanupGL() {
 // ChunkUtils namespace implementation
 namespace ChunkUtils {
 
-    ChunkCoord worldToChunkCoord(int worldX, int worldZ) {
-        // Floor division to handle negative coordinates correctly
-        int chunkX = worldX >= 0 ? worldX / CHUNK_WIDTH : (worldX - CHUNK_WIDTH + 1) / CHUNK_WIDTH;
-        int chunkZ = worldZ >= 0 ? worldZ / CHUNK_DEPTH : (worldZ - CHUNK_DEPTH + 1) / CHUNK_DEPTH;
-        return ChunkCoord(chunkX, chunkZ);
-    }
-
     ChunkCoord worldToChunkCoord(const glm::vec3& worldPos) {
         return worldToChunkCoord(static_cast<int>(std::floor(worldPos.x)),
                                 static_cast<int>(std::floor(worldPos.z)));
     }
 
-    glm::ivec3 worldToLocal(int worldX, int worldY, int worldZ) {
-        ChunkCoord chunkCoord = worldToChunkCoord(worldX, worldZ);
-        int localX = worldX - chunkCoord.x * CHUNK_WIDTH;
-        int localZ = worldZ - chunkCoord.z * CHUNK_DEPTH;
-
-        // Ensure positive local coordinates
-        if (localX < 0) localX += CHUNK_WIDTH;
-        if (localZ < 0) localZ += CHUNK_DEPTH;
-
-        return glm::ivec3(localX, worldY, localZ);
-    }
-
     glm::ivec3 worldToLocal(const glm::vec3& worldPos) {
         return worldToLocal(static_cast<int>(std::floor(worldPos.x)),
                            static_cast<int>(std::floor(worldPos.y)),
@@ -503,7 +855,8 @@ namespace ChunkUtils {
     }
 
     glm::vec3 chunkToWorldPos(const ChunkCoord& coord) {
-        return glm::vec3(coord.x * CHUNK_WIDTH, 0, coord.z * CHUNK_DEPTH);
+        return glm::vec3(CurrentChunkGeometry::chunkToWorldX(coord.x), 0,
+                         CurrentChunkGeometry::chunkToWorldZ(coord.z));
     }
 
     float chunkDistance(const ChunkCoord& a, const ChunkCoord& b) {
@@ -532,82 +885,161 @@ namespace ChunkUtils {
     }
 
     bool isValidBlockCoord(int x, int y, int z) {
-        return x >= 0 && x < CHUNK_WIDTH &&
-               y >= 0 && y < CHUNK_HEIGHT &&
-               z >= 0 && z < CHUNK_DEPTH;
+        return CurrentChunkGeometry::isInBounds(x, y, z);
     }
 }
 
-void Chunk::generate() {
 #ifdef FASTNOISE_AVAILABLE
+// Shared 2D terrain fields - used by chunk generation and by surface height queries
+static FastNoiseLite& getBaseNoise() {
     static FastNoiseLite baseNoise;
+    return baseNoise;
+}
+
+static FastNoiseLite& getMountainNoise() {
     static FastNoiseLite mountainNoise;
-    static bool initialized = false;
+    return mountainNoise;
+}
+
+// The chunk I/O thread samples the generator for delta baselines, so initialization is
+// guarded; reseeding only happens while that thread is idle (see World::regenerateWorld)
+static void ensureTerrainNoiseInitialized() {
+    static std::atomic<bool> initialized(false);
+    static std::mutex initMutex;
 
     // Check if we need to reset (for new seeds)
-    if (g_resetChunkNoise) {
-        initialized = false;
-        g_resetChunkNoise = false;
+    if (g_resetChunkNoise.exchange(false)) {
+        initialized.store(false);
     }
 
-    if (!initialized) {
-        // Base terrain: rolling hills
-        baseNoise.SetSeed(gTerrainSettings.baseSeed);
-        baseNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-        baseNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
-        baseNoise.SetFractalOctaves(5);
-        baseNoise.SetFractalLacunarity(2.0f);
-        baseNoise.SetFractalGain(0.5f);
-        baseNoise.SetRotationType3D(FastNoiseLite::RotationType3D_ImproveXZPlanes);
-
-        // Mountain ridges
-        mountainNoise.SetSeed(gTerrainSettings.mountainSeed);
-        mountainNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-        mountainNoise.SetFractalType(FastNoiseLite::FractalType_Ridged);
-        mountainNoise.SetFractalOctaves(3);
+    if (initialized.load(std::memory_order_acquire)) {
+        return;
+    }
 
-        initialized = true;
+    std::lock_guard<std::mutex> lock(initMutex);
+    if (initialized.load(std::memory_order_relaxed)) {
+        return;
     }
 
+    FastNoiseLite& baseNoise = getBaseNoise();
+    FastNoiseLite& mountainNoise = getMountainNoise();
+
+    // Base terrain: rolling hills
+    baseNoise.SetSeed(gTerrainSettings.baseSeed);
+    baseNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    baseNoise.SetFractalType(FastNoiseLite::FractalType_FBm);
+    baseNoise.SetFractalOctaves(5);
+    baseNoise.SetFractalLacunarity(2.0f);
+    baseNoise.SetFractalGain(0.5f);
+    baseNoise.SetRotationType3D(FastNoiseLite::RotationType3D_ImproveXZPlanes);
     baseNoise.SetFrequency(gTerrainSettings.baseFrequency);
+
+    // Mountain ridges
+    mountainNoise.SetSeed(gTerrainSettings.mountainSeed);
+    mountainNoise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    mountainNoise.SetFractalType(FastNoiseLite::FractalType_Ridged);
+    mountainNoise.SetFractalOctaves(3);
     mountainNoise.SetFrequency(gTerrainSettings.mountainFrequency);
 
+    initialized.store(true, std::memory_order_release);
+}
+
+// Terrain height of one column, assuming the noise fields are initialized
+static int sampleColumnHeight(int worldX, int worldZ) {
+    float x = float(worldX);
+    float z = float(worldZ);
+
+    // Base terrain height
+    float baseHeight = getBaseNoise().GetNoise(x, z);
+    baseHeight = baseHeight * 0.5f + 0.5f; // Normalize to [0,1]
+
+    // Mountain detail for higher elevations
+    float mountainDetail = 0.0f;
+    if (baseHeight > 0.6f) {
+        float rawMountainNoise = getMountainNoise().GetNoise(x, z);
+        float ridged = 1.0f - std::abs(rawMountainNoise);
+        ridged = std::pow(ridged, 3.0f);
+        mountainDetail = ridged * (baseHeight - 0.6f) * 2.5f;
+    }
+
+    // Combine heights
+    float combinedHeight = baseHeight + mountainDetail;
+    if (combinedHeight > 1.5f) combinedHeight = 1.5f;
+
+    return int(combinedHeight * gTerrainSettings.maxTerrainHeight);
+}
+#endif
+
+int Chunk::getColumnHeight(int worldX, int worldZ) {
+#ifdef FASTNOISE_AVAILABLE
+    ensureTerrainNoiseInitialized();
+    return sampleColumnHeight(worldX, worldZ);
+#else
+    (void)worldX;
+    (void)worldZ;
+    return gTerrainSettings.waterLevel;
+#endif
+}
+
+BlockType Chunk::getSurfaceType(int height) {
+    int waterLevel = gTerrainSettings.waterLevel;
+    if (height >= 50) {
+        return BlockType::STONE;   // Mountains
+    }
+    if (height >= waterLevel - 1 && height <= waterLevel + 1) {
+        return BlockType::SAND;    // Beaches
+    }
+    return height > waterLevel + 1 ? BlockType::GRASS : BlockType::SAND;
+}
+
+void Chunk::getColumnHeights(int worldX0, int worldZ0, int width, int depth, int* outHeights) {
+#ifdef FASTNOISE_AVAILABLE
+    ensureTerrainNoiseInitialized();
+    for (int z = 0; z < depth; z++) {
+        for (int x = 0; x < width; x++) {
+            outHeights[z * width + x] = sampleColumnHeight(worldX0 + x, worldZ0 + z);
+        }
+    }
+#else
+    (void)worldX0;
+    (void)worldZ0;
+    std::fill(outHeights, outHeights + width * depth, gTerrainSettings.waterLevel);
+#endif
+}
+
+void Chunk::generate() {
+    generateBlocks(coord, blocks.data());
+    markForRemesh();
+
+    // Set state to generated
+    setState(ChunkState::GENERATED);
+}
+
+void Chunk::generateBlocks(ChunkCoord coord, BlockData* outBlocks) {
+    // Same y-major layout as getBlockIndex()
+    auto blockAt = [outBlocks](int x, int y, int z) -> BlockData& {
+        return outBlocks[CurrentChunkGeometry::blockIndex(x, y, z)];
+    };
+
+#ifdef FASTNOISE_AVAILABLE
     int worldX0 = coord.x * CHUNK_WIDTH;
     int worldZ0 = coord.z * CHUNK_DEPTH;
     int waterLevel = gTerrainSettings.waterLevel;
 
+    int columnHeights[CHUNK_WIDTH * CHUNK_DEPTH];
+    getColumnHeights(worldX0, worldZ0, CHUNK_WIDTH, CHUNK_DEPTH, columnHeights);
+
     for (int x = 0; x < CHUNK_WIDTH; x++) {
         for (int z = 0; z < CHUNK_DEPTH; z++) {
-            float worldX = float(worldX0 + x);
-            float worldZ = float(worldZ0 + z);
-
-            // Base terrain height
-            float baseHeight = baseNoise.GetNoise(worldX, worldZ);
-            baseHeight = baseHeight * 0.5f + 0.5f; // Normalize to [0,1]
-
-            // Mountain detail for higher elevations
-            float mountainDetail = 0.0f;
-            if (baseHeight > 0.6f) {
-                float rawMountainNoise = mountainNoise.GetNoise(worldX, worldZ);
-                float ridged = 1.0f - std::abs(rawMountainNoise);
-                ridged = std::pow(ridged, 3.0f);
-                mountainDetail = ridged * (baseHeight - 0.6f) * 2.5f;
-            }
-
-            // Combine heights
-            float combinedHeight = baseHeight + mountainDetail;
-            if (combinedHeight > 1.5f) combinedHeight = 1.5f;
-
-            int maxTerrainHeight = gTerrainSettings.maxTerrainHeight;
-            int height = int(combinedHeight * maxTerrainHeight);
+            int height = columnHeights[z * CHUNK_WIDTH + x];
 
             // Generate terrain column
             for (int y = 0; y < CHUNK_HEIGHT; y++) {
                 if (y > height && y <= waterLevel) {
-                    setBlock(x, y, z, BlockData(BlockType::WATER));
+                    blockAt(x, y, z) = BlockData(BlockType::WATER);
                 }
                 else if (y > height) {
-                    setBlock(x, y, z, BlockData(BlockType::AIR));
+                    blockAt(x, y, z) = BlockData(BlockType::AIR);
                 }
                 else {
                     bool isMountain = (height >= 50);
@@ -615,59 +1047,50 @@ void Chunk::generate() {
 
                     if (y == height) {
                         // Surface layer
-                        if (isMountain)
-                            setBlock(x, y, z, BlockData(BlockType::STONE));
-                        else if (nearWater)
-                            setBlock(x, y, z, BlockData(BlockType::SAND));
-                        else if (height > waterLevel + 1)
-                            setBlock(x, y, z, BlockData(BlockType::GRASS));
-                        else
-                            setBlock(x, y, z, BlockData(BlockType::SAND));
+                        blockAt(x, y, z) = BlockData(getSurfaceType(height));
                     }
                     else if (y >= height - 4) {
                         // Subsurface layer (up to 4 blocks deep)
                         if (isMountain)
-                            setBlock(x, y, z, BlockData(BlockType::STONE));
+                            blockAt(x, y, z) = BlockData(BlockType::STONE);
                         else if (nearWater)
-                            setBlock(x, y, z, BlockData(BlockType::SAND));
+                            blockAt(x, y, z) = BlockData(BlockType::SAND);
                         else if (height > waterLevel + 1)
-                            setBlock(x, y, z, BlockData(BlockType::DIRT));
+                            blockAt(x, y, z) = BlockData(BlockType::DIRT);
                         else
-                            setBlock(x, y, z, BlockData(BlockType::SAND));
+                            blockAt(x, y, z) = BlockData(BlockType::SAND);
                     }
                     else {
                         // Deep underground - all stone
-                        setBlock(x, y, z, BlockData(BlockType::STONE));
+                        blockAt(x, y, z) = BlockData(BlockType::STONE);
                     }
                 }
             }
         }
     }
-
-    // Set state to generated
-    setState(ChunkState::GENERATED);
 #else
+    (void)coord;
+
     // Fallback to simple flat terrain if FastNoise not available
     for (int x = 0; x < CHUNK_WIDTH; x++) {
         for (int z = 0; z < CHUNK_DEPTH; z++) {
             for (int y = 0; y < CHUNK_HEIGHT; y++) {
                 if (y == 0) {
-                    setBlock(x, y, z, BlockData(BlockType::BEDROCK));
+                    blockAt(x, y, z) = BlockData(BlockType::BEDROCK);
                 } else if (y <= gTerrainSettings.waterLevel) {
                     if (y == gTerrainSettings.waterLevel) {
-                        setBlock(x, y, z, BlockData(BlockType::GRASS));
+                        blockAt(x, y, z) = BlockData(BlockType::GRASS);
                     } else {
-                        setBlock(x, y, z, BlockData(BlockType::DIRT));
+                        blockAt(x, y, z) = BlockData(BlockType::DIRT);
                     }
                 } else if (y <= gTerrainSettings.waterLevel + 5) {
-                    setBlock(x, y, z, BlockData(BlockType::WATER));
+                    blockAt(x, y, z) = BlockData(BlockType::WATER);
                 } else {
-                    setBlock(x, y, z, BlockData(BlockType::AIR));
+                    blockAt(x, y, z) = BlockData(BlockType::AIR);
                 }
             }
         }
     }
-    setState(ChunkState::GENERATED);
 #endif
 }
 
@@ -697,13 +1120,9 @@ bool Chunk::shouldRenderWaterFace(int x, int y, int z, CubeFace face) const {
     // At chunk boundary - check neighboring chunks
     if (world) {
         glm::vec3 chunkWorldPos = getWorldPosition();
-        glm::ivec3 worldAdjacentPos(
-            static_cast<int>(chunkWorldPos.x) + adjacentPos.x,
-            adjacentPos.y,
-            static_cast<int>(chunkWorldPos.z) + adjacentPos.z
-        );
-
-        BlockData adjacentBlock = world->getBlock(worldAdjacentPos.x, worldAdjacentPos.y, worldAdjacentPos.z);
+        BlockCursor neighbor(world, static_cast<int>(chunkWorldPos.x) + adjacentPos.x, adjacentPos.y,
+                             static_cast<int>(chunkWorldPos.z) + adjacentPos.z);
+        BlockData adjacentBlock = neighbor.get();
 
         // Only render if adjacent is air
         if (adjacentBlock.type == BlockType::AIR) {
@@ -1,25 +1,29 @@
 #pragma once
 
 #include "block.h"
+#include "chunk_geometry.h"
+#include "../renderer/render_queue.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glad/glad.h>
 #include <array>
+#include <bitset>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 // Forward declaration
 class World;
 
-// Chunk dimensions
-constexpr int CHUNK_WIDTH = 16;
-constexpr int CHUNK_HEIGHT = 256;
-constexpr int CHUNK_DEPTH = 16;
-constexpr int BLOCKS_PER_CHUNK = CHUNK_WIDTH * CHUNK_HEIGHT * CHUNK_DEPTH;
+// Chunk dimensions (see chunk_geometry.h - sizes are powers of two)
+constexpr int CHUNK_WIDTH = CurrentChunkGeometry::WIDTH;
+constexpr int CHUNK_HEIGHT = CurrentChunkGeometry::HEIGHT;
+constexpr int CHUNK_DEPTH = CurrentChunkGeometry::DEPTH;
+constexpr int BLOCKS_PER_CHUNK = CurrentChunkGeometry::VOLUME;
 
 // Performance constants
 constexpr int MAX_VERTICES_PER_CHUNK = BLOCKS_PER_CHUNK * 6 * 4; // Max faces * 4 vertices
-constexpr int VERTEX_STRIDE = 8; // Position(3) + Normal(3) + TexCoord(2)
+constexpr int VERTEX_STRIDE = 6; // Position(3) + face ID(1, a CubeFace - the shader looks up its normal) + TexCoord(2)
 
 // Chunk coordinate system
 struct ChunkCoord {
@@ -90,10 +94,26 @@ public:
 
     // Terrain generation
     void generate();
+    // Deterministic generator output for a chunk, written to a raw BLOCKS_PER_CHUNK array
+    static void generateBlocks(ChunkCoord coord, BlockData* outBlocks);
+    // Bump whenever generateBlocks() output changes - saved deltas are only valid against it
+    static constexpr uint32_t GENERATOR_VERSION = 1;
+
+    // Generator height fields - evaluate only the 2D noise, no block storage involved
+    static int getColumnHeight(int worldX, int worldZ);
+    static void getColumnHeights(int worldX0, int worldZ0, int width, int depth, int* outHeights);
+    // Block the generator places on top of a column of the given height
+    static BlockType getSurfaceType(int height);
+
+    // Recycle this chunk for another position, keeping its block storage and GL objects
+    // (blocks are left as they are - every load path overwrites all of them)
+    void reset(ChunkCoord newCoord);
 
     // Mesh management
     void generateMesh();
-    void render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos);
+    // Queue the mesh for drawing (skipped when empty or beyond the render distance): opaque
+    // faces as one draw without blending, water and leaves as a second, blended draw
+    void submitDraw(RenderQueue& queue, const RenderQueue::DrawState& state, const glm::vec3& cameraPos) const;
     void clearMesh();
 
     // State management
@@ -103,6 +123,68 @@ public:
     bool needsRemeshing() const { return meshDirty; }
     void markForRemesh() { meshDirty = true; }
 
+    // Persistence tracking - set when the player edits the chunk after it was loaded
+    bool isModified() const { return modified; }
+    void setModified(bool value) { modified = value; }
+
+    // Raw block storage (y-major, see getBlockIndex) for serialization
+    // Call recountSections() after writing through the mutable pointer
+    const BlockData* getBlockData() const { return blocks.data(); }
+    BlockData* getBlockData() { return blocks.data(); }
+
+    // Section occupancy - non-air blocks per SECTION_HEIGHT-layer slice of the column
+    // (maintained by setBlock; recount after bulk writes to getBlockData())
+    void recountSections();
+    void recountSections(int firstSection, int lastSection);
+    int getSectionBlockCount(int section) const { return sectionBlockCounts[section]; }
+    bool isSectionEmpty(int section) const { return sectionBlockCounts[section] == 0; }
+
+    // Vertical extent of the current mesh in local y (max is exclusive) - culling boxes use
+    // these instead of the full column height. Both are 0 when the mesh is empty.
+    int getMeshMinY() const { return meshMinY; }
+    int getMeshMaxY() const { return meshMaxY; }
+    bool hasMesh() const { return hasGeometry; }
+    // Sections that contributed at least one face to the current mesh
+    bool isSectionMeshed(int section) const { return meshedSections.test(section); }
+
+    // Vertical streaming - only sections in [minSection, maxSection] are meshed
+    // Marks the chunk for remeshing only if a non-empty section enters or leaves the range
+    void setMeshSectionRange(int minSection, int maxSection);
+
+    // Occlusion culling - for each OCCLUDER_CELL x OCCLUDER_CELL block of columns, the height
+    // of the run of opaque blocks all of its columns have from y = 0 (refreshed with the mesh)
+    static constexpr int OCCLUDER_CELL = 4;
+    static constexpr int OCCLUDER_CELLS_X = CHUNK_WIDTH / OCCLUDER_CELL;
+    static constexpr int OCCLUDER_CELLS_Z = CHUNK_DEPTH / OCCLUDER_CELL;
+    int getOccluderHeight(int cellX, int cellZ) const { return occluderHeights[cellZ * OCCLUDER_CELLS_X + cellX]; }
+
+    // Cave culling - which pairs of a section's six faces are joined through its non-opaque
+    // blocks, one bit per unordered pair (see facePairBit); refreshed with the mesh
+    static constexpr uint16_t ALL_FACES_CONNECTED = 0x7FFF;
+    static constexpr uint16_t facePairBit(CubeFace a, CubeFace b) {
+        return static_cast<int>(a) > static_cast<int>(b) ? facePairBit(b, a)
+             : static_cast<uint16_t>(1u << (static_cast<int>(a) * (11 - static_cast<int>(a)) / 2 +
+                                            static_cast<int>(b) - static_cast<int>(a) - 1));
+    }
+    uint16_t getSectionConnectivity(int section) const { return sectionConnectivity[section]; }
+    const uint16_t* getSectionConnectivityData() const { return sectionConnectivity.data(); }
+    // Face pairs joined inside one section's SECTION_VOLUME blocks (y-major, as stored), with
+    // opaque[type] marking the block types that stop the flood fill. Needs no GL or registry,
+    // so hand-built sections can be checked directly; stack is scratch and may be reused.
+    using OpacityTable = std::array<bool, static_cast<size_t>(BlockType::COUNT)>;
+    static uint16_t computeSectionConnectivity(const BlockData* sectionBlocks, const OpacityTable& opaque,
+                                               std::vector<int>& stack);
+
+    // Level of detail - at level n the mesh is built from 2^n-block cells, each the majority
+    // vote of its blocks, with skirts hanging from surface cells along the chunk border to hide
+    // seams against neighbours at other levels. Returns true (and marks the chunk for
+    // remeshing) if the level changed.
+    static constexpr int MAX_LOD_LEVEL = 2;
+    bool setLodLevel(int level);
+    int getLodLevel() const { return lodLevel; }
+    // Block type at a local position as the current level's mesh represents it
+    BlockType getMeshedBlockType(int x, int y, int z) const;
+
     // Coordinate utilities
     ChunkCoord getCoord() const { return coord; }
     glm::vec3 getWorldPosition() const;
@@ -119,19 +201,35 @@ public:
     // Statistics
     int getVertexCount() const { return vertexCount; }
     int getTriangleCount() const { return vertexCount / 3; }
+    size_t getBlockBytes() const { return sizeof(blocks); }
+    size_t getGpuBytes() const { return bufferCapacity; }
+    // CPU vertex scratch shared by all mesh builds (kept at its high-water mark)
+    static size_t getMeshScratchBytes();
 
 private:
     // Core data
     ChunkCoord coord;
     ChunkState state;
     std::array<BlockData, BLOCKS_PER_CHUNK> blocks;
+    std::array<uint16_t, CurrentChunkGeometry::SECTION_COUNT> sectionBlockCounts;
+    int meshMinSection;
+    int meshMaxSection;
+    int lodLevel;
     World* world;
 
     // Rendering data
     GLuint VAO, VBO;
+    size_t bufferCapacity;  // Bytes allocated in VBO; smaller meshes reuse the storage
     size_t vertexCount;
+    size_t opaqueVertexCount;   // Opaque faces come first in the VBO, transparent ones after
     bool meshDirty;
     bool hasGeometry;
+    int meshMinY;
+    int meshMaxY;
+    std::bitset<CurrentChunkGeometry::SECTION_COUNT> meshedSections;
+    std::array<uint16_t, OCCLUDER_CELLS_X * OCCLUDER_CELLS_Z> occluderHeights;
+    std::array<uint16_t, CurrentChunkGeometry::SECTION_COUNT> sectionConnectivity;
+    bool modified;
 
     // Neighbor tracking for dynamic updates
     bool neighborsAvailable[4]; // N, S, E, W neighbors
@@ -139,8 +237,13 @@ private:
     float lastNeighborCheck;
 
     // Mesh generation helpers
+    void updateOccluderHeights();
+    void generateLodMesh(std::vector<float>& vertices);
+    BlockType voteCell(int size, int x0, int y0, int z0) const;
+    bool shouldRenderLodFace(int size, int x0, int y0, int z0, CubeFace face, const Block& block) const;
+    void updateSectionConnectivity();
     void addFace(std::vector<float>& vertices, const glm::vec3& pos,
-                 CubeFace face, BlockType blockType);
+                 CubeFace face, BlockType blockType, const glm::vec3& size = glm::vec3(1.0f));
     void addQuadVertices(std::vector<float>& vertices,
                         const std::array<glm::vec3, 4>& corners,
                         const glm::vec3& normal,
@@ -162,12 +265,17 @@ private:
 
 // Chunk coordinate utility functions
 namespace ChunkUtils {
-    // Convert world coordinates to chunk coordinates
-    ChunkCoord worldToChunkCoord(int worldX, int worldZ);
+    // Convert world coordinates to chunk coordinates (shift - floors negative coordinates)
+    inline ChunkCoord worldToChunkCoord(int worldX, int worldZ) {
+        return ChunkCoord(CurrentChunkGeometry::worldToChunkX(worldX), CurrentChunkGeometry::worldToChunkZ(worldZ));
+    }
     ChunkCoord worldToChunkCoord(const glm::vec3& worldPos);
 
-    // Convert world coordinates to local chunk coordinates
-    glm::ivec3 worldToLocal(int worldX, int worldY, int worldZ);
+    // Convert world coordinates to local chunk coordinates (mask - always non-negative)
+    inline glm::ivec3 worldToLocal(int worldX, int worldY, int worldZ) {
+        return glm::ivec3(CurrentChunkGeometry::worldToLocalX(worldX), worldY,
+                          CurrentChunkGeometry::worldToLocalZ(worldZ));
+    }
     glm::ivec3 worldToLocal(const glm::vec3& worldPos);
 
     // Convert chunk coordinates to world position
@@ -0,0 +1,82 @@
+#include "chunk_cache.h"
+#include "region_file.h"
+#include <cstring>
+
+ChunkCache::ChunkCache(size_t byteBudget) : budget(byteBudget), bytes(0), hits(0), misses(0) {
+}
+
+void ChunkCache::store(ChunkCoord coord, const BlockData* blocks) {
+    erase(coord);
+
+    Entry entry{coord, {}, true};
+    ChunkCodec::compress(blocks, BLOCKS_PER_CHUNK, entry.data);
+    if (entry.data.size() >= sizeof(BlockData) * BLOCKS_PER_CHUNK) {
+        entry.data.resize(sizeof(BlockData) * BLOCKS_PER_CHUNK);
+        std::memcpy(entry.data.data(), blocks, entry.data.size());
+        entry.compressed = false;
+    }
+    entry.data.shrink_to_fit();
+
+    bytes += entry.data.size();
+    entries.push_front(std::move(entry));
+    index[coord] = entries.begin();
+    evictToBudget();
+}
+
+bool ChunkCache::take(ChunkCoord coord, BlockData* outBlocks) {
+    auto it = index.find(coord);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+
+    const Entry& entry = *it->second;
+    bool decoded = true;
+    if (entry.compressed) {
+        decoded = ChunkCodec::decompress(entry.data.data(), entry.data.size(), outBlocks, BLOCKS_PER_CHUNK);
+    } else {
+        std::memcpy(outBlocks, entry.data.data(), entry.data.size());
+    }
+
+    erase(coord);
+    if (!decoded) {
+        misses++;
+        return false;
+    }
+    hits++;
+    return true;
+}
+
+void ChunkCache::erase(ChunkCoord coord) {
+    auto it = index.find(coord);
+    if (it == index.end()) return;
+
+    bytes -= it->second->data.size();
+    entries.erase(it->second);
+    index.erase(it);
+}
+
+void ChunkCache::clear() {
+    entries.clear();
+    index.clear();
+    bytes = 0;
+}
+
+void ChunkCache::setBudget(size_t newBudget) {
+    budget = newBudget;
+    evictToBudget();
+}
+
+float ChunkCache::getHitRate() const {
+    uint64_t lookups = hits + misses;
+    return lookups > 0 ? static_cast<float>(hits) / static_cast<float>(lookups) : 0.0f;
+}
+
+void ChunkCache::trim(size_t maxBytes) {
+    while (bytes > maxBytes && !entries.empty()) {
+        const Entry& oldest = entries.back();
+        bytes -= oldest.data.size();
+        index.erase(oldest.coord);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "chunk.h"
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file chunk_cache.h
+ * @brief Byte-budgeted LRU cache of recently unloaded chunks
+ *
+ * Walking back and forth across the unload boundary otherwise regenerates the same chunks
+ * from noise every time. Unloaded chunks keep their blocks here, run-length encoded, until
+ * the byte budget pushes them out; a reload takes the entry back out of the cache.
+ *
+ * Main thread only.
+ */
+class ChunkCache {
+public:
+    explicit ChunkCache(size_t byteBudget = DEFAULT_BUDGET_BYTES);
+
+    // Keep a copy of the blocks, evicting least recently unloaded chunks over budget
+    void store(ChunkCoord coord, const BlockData* blocks);
+    // Decode a cached chunk into outBlocks and remove it from the cache
+    bool take(ChunkCoord coord, BlockData* outBlocks);
+    void erase(ChunkCoord coord);
+    void clear();
+
+    // Evict least recently unloaded chunks until at most maxBytes remain (budget unchanged)
+    void trim(size_t maxBytes);
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return budget; }
+
+    // Statistics
+    size_t getBytes() const { return bytes; }
+    size_t getEntryCount() const { return entries.size(); }
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+    float getHitRate() const;
+
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 32 * 1024 * 1024;
+
+private:
+    struct Entry {
+        ChunkCoord coord;
+        std::vector<uint8_t> data;
+        bool compressed;    // RLE, or a raw copy when RLE would be larger
+    };
+
+    std::list<Entry> entries;   // Most recently stored first
+    std::unordered_map<ChunkCoord, std::list<Entry>::iterator, ChunkCoord::Hash> index;
+    size_t budget;
+    size_t bytes;
+    uint64_t hits;
+    uint64_t misses;
+
+    void evictToBudget() { trim(budget); }
+};
@@ -0,0 +1,178 @@
+#include "chunk_cull_tree.h"
+#include <algorithm>
+
+void ChunkCullTree::insert(Chunk* chunk) {
+    ChunkCoord coord = chunk->getCoord();
+    remove(coord);  // A chunk replaced in place must not be listed twice
+
+    ChunkCoord tileKey = tileOf(coord);
+    auto tileIt = tiles.find(tileKey);
+    if (tileIt == tiles.end()) {
+        tileIt = tiles.emplace(tileKey, Tile()).first;
+        groups[groupOf(tileKey)].tiles.push_back(tileKey);
+    }
+    tileIt->second.chunks.push_back(chunk);
+    chunkCount++;
+
+    refreshTile(tileKey);
+}
+
+void ChunkCullTree::remove(ChunkCoord coord) {
+    ChunkCoord tileKey = tileOf(coord);
+    auto tileIt = tiles.find(tileKey);
+    if (tileIt == tiles.end()) return;
+
+    std::vector<Chunk*>& members = tileIt->second.chunks;
+    auto it = std::find_if(members.begin(), members.end(), [&](const Chunk* chunk) {
+        return chunk->getCoord() == coord;
+    });
+    if (it == members.end()) return;
+
+    *it = members.back();
+    members.pop_back();
+    chunkCount--;
+
+    if (!members.empty()) {
+        refreshTile(tileKey);
+        return;
+    }
+
+    // Last chunk of the tile - drop the tile, and the group if it was its last tile
+    tiles.erase(tileIt);
+    ChunkCoord groupKey = groupOf(tileKey);
+    Group& group = groups[groupKey];
+    group.tiles.erase(std::find(group.tiles.begin(), group.tiles.end(), tileKey));
+    if (group.tiles.empty()) {
+        groups.erase(groupKey);
+    } else {
+        refreshGroup(groupKey);
+    }
+}
+
+void ChunkCullTree::update(const Chunk* chunk) {
+    ChunkCoord tileKey = tileOf(chunk->getCoord());
+    if (tiles.count(tileKey)) {
+        refreshTile(tileKey);
+    }
+}
+
+void ChunkCullTree::clear() {
+    tiles.clear();
+    groups.clear();
+    chunkCount = 0;
+}
+
+void ChunkCullTree::refreshTile(ChunkCoord tileKey) {
+    Tile& tile = tiles[tileKey];
+    tile.minY = CHUNK_HEIGHT;
+    tile.maxY = 0;
+    tile.meshedChunks = 0;
+    for (const Chunk* chunk : tile.chunks) {
+        if (!chunk->hasMesh()) continue;
+        tile.minY = std::min(tile.minY, chunk->getMeshMinY());
+        tile.maxY = std::max(tile.maxY, chunk->getMeshMaxY());
+        tile.meshedChunks++;
+    }
+    refreshGroup(groupOf(tileKey));
+}
+
+void ChunkCullTree::refreshGroup(ChunkCoord groupKey) {
+    Group& group = groups[groupKey];
+    group.minY = CHUNK_HEIGHT;
+    group.maxY = 0;
+    group.meshedChunks = 0;
+    for (const ChunkCoord& tileKey : group.tiles) {
+        const Tile& tile = tiles.at(tileKey);
+        if (tile.meshedChunks == 0) continue;
+        group.minY = std::min(group.minY, tile.minY);
+        group.maxY = std::max(group.maxY, tile.maxY);
+        group.meshedChunks += tile.meshedChunks;
+    }
+}
+
+void ChunkCullTree::cullNode(const MathUtils::Frustum& frustum, const glm::vec3& min, const glm::vec3& max,
+                             int meshedChunks, Stats& stats) {
+    stats.culled += meshedChunks;
+    if (frustum.containsAABB(glm::vec3(min.x, 0.0f, min.z), glm::vec3(max.x, static_cast<float>(CHUNK_HEIGHT), max.z))) {
+        stats.tightBoundsCulled += meshedChunks;
+    }
+}
+
+void ChunkCullTree::acceptTile(const Tile& tile, std::vector<Chunk*>& visible, Stats& stats) {
+    for (Chunk* chunk : tile.chunks) {
+        if (chunk->isReady() && chunk->hasMesh()) {
+            visible.push_back(chunk);
+            stats.visible++;
+        }
+    }
+}
+
+void ChunkCullTree::query(const MathUtils::Frustum& frustum, std::vector<Chunk*>& visible, Stats& stats) const {
+    using MathUtils::FrustumTest;
+    const float tileWidth = static_cast<float>(CHUNK_WIDTH << TILE_SHIFT);
+    const float tileDepth = static_cast<float>(CHUNK_DEPTH << TILE_SHIFT);
+    const float groupWidth = static_cast<float>(CHUNK_WIDTH << GROUP_SHIFT);
+    const float groupDepth = static_cast<float>(CHUNK_DEPTH << GROUP_SHIFT);
+
+    for (const auto& groupPair : groups) {
+        const Group& group = groupPair.second;
+        if (group.meshedChunks == 0) continue;
+
+        glm::vec3 groupMin(groupPair.first.x * groupWidth, static_cast<float>(group.minY), groupPair.first.z * groupDepth);
+        glm::vec3 groupMax(groupMin.x + groupWidth, static_cast<float>(group.maxY), groupMin.z + groupDepth);
+        FrustumTest groupTest = frustum.classifyAABB(groupMin, groupMax);
+        stats.frustumTests++;
+        if (groupTest == FrustumTest::OUTSIDE) {
+            cullNode(frustum, groupMin, groupMax, group.meshedChunks, stats);
+            continue;
+        }
+
+        for (const ChunkCoord& tileKey : group.tiles) {
+            const Tile& tile = tiles.at(tileKey);
+            if (tile.meshedChunks == 0) continue;
+
+            // Everything under a fully visible group is visible without further tests
+            if (groupTest == FrustumTest::INSIDE) {
+                acceptTile(tile, visible, stats);
+                continue;
+            }
+
+            glm::vec3 tileMin(tileKey.x * tileWidth, static_cast<float>(tile.minY), tileKey.z * tileDepth);
+            glm::vec3 tileMax(tileMin.x + tileWidth, static_cast<float>(tile.maxY), tileMin.z + tileDepth);
+            FrustumTest tileTest = frustum.classifyAABB(tileMin, tileMax);
+            stats.frustumTests++;
+            if (tileTest == FrustumTest::OUTSIDE) {
+                cullNode(frustum, tileMin, tileMax, tile.meshedChunks, stats);
+                continue;
+            }
+            if (tileTest == FrustumTest::INSIDE) {
+                acceptTile(tile, visible, stats);
+                continue;
+            }
+
+            // Straddling tile - test its chunks' tight boxes in one batch
+            batchChunks.clear();
+            batchBoxes.clear();
+            for (Chunk* chunk : tile.chunks) {
+                if (!chunk->isReady() || !chunk->hasMesh()) continue;
+
+                glm::vec3 chunkPos = chunk->getWorldPosition();
+                batchBoxes.add(chunkPos + glm::vec3(0.0f, static_cast<float>(chunk->getMeshMinY()), 0.0f),
+                               chunkPos + glm::vec3(CHUNK_WIDTH, static_cast<float>(chunk->getMeshMaxY()), CHUNK_DEPTH));
+                batchChunks.push_back(chunk);
+            }
+
+            frustum.containsAABBs(batchBoxes, batchMask);
+            stats.frustumTests += static_cast<int>(batchChunks.size());
+            for (size_t i = 0; i < batchChunks.size(); i++) {
+                if (batchMask[i / 32] & (1u << (i % 32))) {
+                    visible.push_back(batchChunks[i]);
+                    stats.visible++;
+                } else {
+                    cullNode(frustum, glm::vec3(batchBoxes.minX[i], batchBoxes.minY[i], batchBoxes.minZ[i]),
+                             glm::vec3(batchBoxes.maxX[i], batchBoxes.maxY[i], batchBoxes.maxZ[i]), 1, stats);
+                }
+            }
+        }
+    }
+}
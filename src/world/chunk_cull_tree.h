@@ -0,0 +1,82 @@
+#pragma once
+
+#include "chunk.h"
+#include "../utils/math_utils.h"
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file chunk_cull_tree.h
+ * @brief Hierarchical frustum culling over the loaded chunk grid
+ *
+ * Loaded chunks are bucketed into tiles of 4 x 4 chunks and tiles into groups of 16 x 16
+ * chunks. Tiles and groups keep the vertical extent of their members' meshes, so a single
+ * frustum test rejects - or, when the node is entirely inside, accepts - every chunk under
+ * it. Only chunks in tiles that straddle a frustum plane are tested individually, as one
+ * SoA batch per tile (Frustum::containsAABBs).
+ *
+ * Membership mirrors World's chunk map (insert when a chunk is added, remove when it is
+ * unloaded); call update() after a chunk is remeshed so node bounds follow its mesh.
+ */
+class ChunkCullTree {
+public:
+    struct Stats {
+        int frustumTests = 0;
+        int visible = 0;
+        int culled = 0;
+        // Culled chunks whose full-height box would have passed; counted per rejected node,
+        // so this is an upper bound when a whole tile or group is rejected
+        int tightBoundsCulled = 0;
+    };
+
+    void insert(Chunk* chunk);
+    void remove(ChunkCoord coord);
+    void update(const Chunk* chunk);
+    void clear();
+
+    // Appends every ready, meshed chunk whose box intersects the frustum to visible
+    void query(const MathUtils::Frustum& frustum, std::vector<Chunk*>& visible, Stats& stats) const;
+
+    size_t getChunkCount() const { return chunkCount; }
+
+    static constexpr int TILE_SHIFT = 2;    // 4 x 4 chunks per tile
+    static constexpr int GROUP_SHIFT = 4;   // 16 x 16 chunks per group
+
+private:
+    struct Node {
+        int minY = 0;               // Mesh extent of the members, local y (max exclusive)
+        int maxY = 0;
+        int meshedChunks = 0;       // Members with a non-empty mesh
+    };
+    struct Tile : Node {
+        std::vector<Chunk*> chunks;
+    };
+    struct Group : Node {
+        std::vector<ChunkCoord> tiles;
+    };
+
+    std::unordered_map<ChunkCoord, Tile, ChunkCoord::Hash> tiles;
+    std::unordered_map<ChunkCoord, Group, ChunkCoord::Hash> groups;
+    size_t chunkCount = 0;
+
+    // Scratch for batched chunk tests in straddling tiles (reused across queries)
+    mutable MathUtils::AABBBatch batchBoxes;
+    mutable std::vector<Chunk*> batchChunks;
+    mutable std::vector<uint32_t> batchMask;
+
+    static ChunkCoord tileOf(ChunkCoord coord) {
+        return ChunkCoord(coord.x >> TILE_SHIFT, coord.z >> TILE_SHIFT);
+    }
+    static ChunkCoord groupOf(ChunkCoord tileKey) {
+        return ChunkCoord(tileKey.x >> (GROUP_SHIFT - TILE_SHIFT), tileKey.z >> (GROUP_SHIFT - TILE_SHIFT));
+    }
+
+    void refreshTile(ChunkCoord tileKey);
+    void refreshGroup(ChunkCoord groupKey);
+
+    // Reject a node: count its meshed chunks as culled (and as tight-bounds culls if its
+    // full-height box would have passed)
+    static void cullNode(const MathUtils::Frustum& frustum, const glm::vec3& min, const glm::vec3& max,
+                         int meshedChunks, Stats& stats);
+    static void acceptTile(const Tile& tile, std::vector<Chunk*>& visible, Stats& stats);
+};
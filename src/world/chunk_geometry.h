@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file chunk_geometry.h
+ * @brief Compile-time chunk dimensions with shift/mask coordinate math
+ *
+ * Chunk sizes must be powers of two so every world <-> chunk <-> local conversion is a
+ * single arithmetic shift or mask. Arithmetic right shift rounds toward negative infinity,
+ * which is exactly the floor division negative world coordinates need, with no branch.
+ *
+ * Storage is y-major: index = (y * DEPTH + z) * WIDTH + x. A column is split vertically into
+ * sections of SECTION_HEIGHT layers; with y-major storage each section is one contiguous
+ * run of SECTION_VOLUME blocks.
+ *
+ * The whole game uses CurrentChunkGeometry; change that one alias to try another size
+ * (e.g. ChunkGeometry<32, 256, 32>).
+ */
+
+namespace ChunkGeometryDetail {
+    constexpr bool isPowerOfTwo(int value) {
+        return value > 0 && (value & (value - 1)) == 0;
+    }
+
+    constexpr int log2(int value) {
+        return value <= 1 ? 0 : 1 + log2(value >> 1);
+    }
+}
+
+// Right-shifting a negative int is implementation-defined before C++20; every supported
+// compiler shifts arithmetically, and the conversions below depend on it
+static_assert((-1 >> 1) == -1 && (-17 >> 4) == -2, "Arithmetic right shift required for chunk coordinate math");
+
+template <int Width, int Height, int Depth>
+struct ChunkGeometry {
+    static_assert(ChunkGeometryDetail::isPowerOfTwo(Width), "Chunk width must be a power of two");
+    static_assert(ChunkGeometryDetail::isPowerOfTwo(Height), "Chunk height must be a power of two");
+    static_assert(ChunkGeometryDetail::isPowerOfTwo(Depth), "Chunk depth must be a power of two");
+
+    static constexpr int WIDTH = Width;
+    static constexpr int HEIGHT = Height;
+    static constexpr int DEPTH = Depth;
+    static constexpr int VOLUME = Width * Height * Depth;
+
+    static constexpr int WIDTH_SHIFT = ChunkGeometryDetail::log2(Width);
+    static constexpr int DEPTH_SHIFT = ChunkGeometryDetail::log2(Depth);
+    static constexpr int LAYER_SHIFT = WIDTH_SHIFT + DEPTH_SHIFT;   // One y layer = WIDTH * DEPTH blocks
+
+    static constexpr int SECTION_HEIGHT = 16;
+    static constexpr int SECTION_SHIFT = ChunkGeometryDetail::log2(SECTION_HEIGHT);
+    static constexpr int SECTION_COUNT = Height >> SECTION_SHIFT;
+    static constexpr int SECTION_VOLUME = SECTION_HEIGHT << LAYER_SHIFT;
+    static_assert(Height % SECTION_HEIGHT == 0, "Chunk height must be a whole number of sections");
+
+    static constexpr int WIDTH_MASK = Width - 1;
+    static constexpr int HEIGHT_MASK = Height - 1;
+    static constexpr int DEPTH_MASK = Depth - 1;
+
+    // World block coordinate -> chunk coordinate (floor division)
+    static constexpr int worldToChunkX(int worldX) { return worldX >> WIDTH_SHIFT; }
+    static constexpr int worldToChunkZ(int worldZ) { return worldZ >> DEPTH_SHIFT; }
+
+    // World block coordinate -> local coordinate inside its chunk (always non-negative)
+    static constexpr int worldToLocalX(int worldX) { return worldX & WIDTH_MASK; }
+    static constexpr int worldToLocalZ(int worldZ) { return worldZ & DEPTH_MASK; }
+
+    // Chunk coordinate -> world coordinate of its first block
+    static constexpr int chunkToWorldX(int chunkX) { return chunkX * Width; }
+    static constexpr int chunkToWorldZ(int chunkZ) { return chunkZ * Depth; }
+
+    // Block y (local or world - columns start at y = 0) -> section index
+    static constexpr int sectionOf(int y) { return y >> SECTION_SHIFT; }
+
+    // Local coordinate <-> storage index
+    static constexpr int blockIndex(int x, int y, int z) {
+        return (y << LAYER_SHIFT) | (z << WIDTH_SHIFT) | x;
+    }
+    static constexpr int indexToX(int index) { return index & WIDTH_MASK; }
+    static constexpr int indexToY(int index) { return index >> LAYER_SHIFT; }
+    static constexpr int indexToZ(int index) { return (index >> WIDTH_SHIFT) & DEPTH_MASK; }
+
+    // Branchless bounds test: any bit outside the mask means out of range (including negatives)
+    static constexpr bool isInBounds(int x, int y, int z) {
+        return ((x & ~WIDTH_MASK) | (y & ~HEIGHT_MASK) | (z & ~DEPTH_MASK)) == 0;
+    }
+};
+
+using CurrentChunkGeometry = ChunkGeometry<16, 256, 16>;
@@ -0,0 +1,195 @@
+#include "chunk_io.h"
+#include "region_file.h"
+#include "edit_journal.h"
+#include <algorithm>
+#include <cstring>
+
+ChunkIOThread::ChunkIOThread(ChunkStorage* storage, int syncIntervalMs, EditJournal* journal)
+    : storage(storage), journal(journal), stopRequested(false), flushRequested(false),
+      unsyncedWrites(false), compactionRequested(false),
+      syncInterval(std::chrono::milliseconds(syncIntervalMs)),
+      bytesWritten(0), chunksWritten(0), savesCoalesced(0) {
+    worker = std::thread(&ChunkIOThread::run, this);
+}
+
+ChunkIOThread::~ChunkIOThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wakeCondition.notify_one();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void ChunkIOThread::queueSave(const Chunk& chunk) {
+    // Grab a recycled buffer, copy outside the lock, then publish
+    Snapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeBuffers.empty()) {
+            snapshot = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+    }
+    if (!snapshot) {
+        snapshot.reset(new BlockData[BLOCKS_PER_CHUNK]);
+    }
+
+    std::memcpy(snapshot.get(), chunk.getBlockData(), sizeof(BlockData) * BLOCKS_PER_CHUNK);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pending.find(chunk.getCoord());
+        if (it != pending.end()) {
+            // Newer snapshot replaces the queued one - only the latest state is written
+            std::swap(it->second, snapshot);
+            if (freeBuffers.size() < MAX_FREE_BUFFERS) {
+                freeBuffers.push_back(std::move(snapshot));
+            }
+            savesCoalesced++;
+        } else {
+            pending.emplace(chunk.getCoord(), std::move(snapshot));
+        }
+    }
+    wakeCondition.notify_one();
+}
+
+bool ChunkIOThread::copyPending(ChunkCoord coord, BlockData* outBlocks) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Queued snapshots are newer than the batch being written
+    auto it = pending.find(coord);
+    if (it == pending.end()) {
+        it = writing.find(coord);
+        if (it == writing.end()) {
+            return false;
+        }
+    }
+
+    std::memcpy(outBlocks, it->second.get(), sizeof(BlockData) * BLOCKS_PER_CHUNK);
+    return true;
+}
+
+void ChunkIOThread::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    flushRequested = true;
+    wakeCondition.notify_one();
+    idleCondition.wait(lock, [this] {
+        return pending.empty() && writing.empty() && !unsyncedWrites;
+    });
+}
+
+void ChunkIOThread::requestJournalCompaction() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        compactionRequested = true;
+    }
+    wakeCondition.notify_one();
+}
+
+void ChunkIOThread::setSyncInterval(int milliseconds) {
+    syncInterval.store(std::chrono::milliseconds(std::max(0, milliseconds)));
+    wakeCondition.notify_one();
+}
+
+int ChunkIOThread::getQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(pending.size() + writing.size());
+}
+
+void ChunkIOThread::run() {
+    auto lastSync = std::chrono::steady_clock::now();
+    auto wakePredicate = [this] {
+        return stopRequested || flushRequested || compactionRequested || !pending.empty();
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        // Wake at least once per commit interval while journaling; otherwise only when a
+        // sync is outstanding (a zero interval must not spin)
+        auto timeout = syncInterval.load();
+        if (journal) {
+            timeout = std::min(timeout, std::chrono::milliseconds(JOURNAL_COMMIT_INTERVAL_MS));
+        }
+        if (journal || unsyncedWrites) {
+            wakeCondition.wait_for(lock, std::max(timeout, std::chrono::milliseconds(1)), wakePredicate);
+        } else {
+            wakeCondition.wait(lock, wakePredicate);
+        }
+
+        // Snapshots queued before the compaction request are in this batch
+        bool compacting = compactionRequested;
+        compactionRequested = false;
+
+        if (journal) {
+            // Group commit - and write-ahead: records reach the journal before any snapshot
+            lock.unlock();
+            journal->commit();
+            lock.lock();
+        }
+
+        if (!pending.empty()) {
+            writing.swap(pending);
+            lock.unlock();
+            writeBatch();
+            lock.lock();
+
+            // Recycle the written snapshots
+            for (auto& pair : writing) {
+                if (freeBuffers.size() < MAX_FREE_BUFFERS) {
+                    freeBuffers.push_back(std::move(pair.second));
+                }
+            }
+            writing.clear();
+            unsyncedWrites = true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        bool syncDue = now - lastSync >= syncInterval.load();
+        if (compacting || (unsyncedWrites && pending.empty() && (syncDue || flushRequested || stopRequested))) {
+            lock.unlock();
+            storage->sync();
+            if (compacting && journal) {
+                journal->dropRetired();
+            }
+            lock.lock();
+            lastSync = now;
+            unsyncedWrites = false;
+        }
+
+        if (pending.empty() && !unsyncedWrites) {
+            flushRequested = false;
+            idleCondition.notify_all();
+            if (stopRequested) {
+                break;
+            }
+        }
+    }
+}
+
+void ChunkIOThread::writeBatch() {
+    // Group writes by region file, then by position inside the file
+    std::vector<std::pair<ChunkCoord, const BlockData*>> batch;
+    batch.reserve(writing.size());
+    for (const auto& pair : writing) {
+        batch.emplace_back(pair.first, pair.second.get());
+    }
+
+    std::sort(batch.begin(), batch.end(), [](const auto& a, const auto& b) {
+        ChunkCoord regionA = RegionFile::chunkToRegion(a.first);
+        ChunkCoord regionB = RegionFile::chunkToRegion(b.first);
+        if (regionA != regionB) return regionA < regionB;
+        return RegionFile::chunkToLocalIndex(a.first) < RegionFile::chunkToLocalIndex(b.first);
+    });
+
+    for (const auto& entry : batch) {
+        size_t written = 0;
+        if (storage->saveChunk(entry.first, entry.second, &written)) {
+            bytesWritten += written;
+            chunksWritten++;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "chunk.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ChunkStorage;
+class EditJournal;
+
+/**
+ * @file chunk_io.h
+ * @brief Dedicated I/O thread for chunk saves
+ *
+ * The main thread only copies the chunk's blocks into an immutable snapshot buffer.
+ * Everything else - delta encoding, region writes and fsync - happens on the I/O thread:
+ *   - repeated saves of the same chunk before it is written coalesce into one write
+ *   - each batch is written grouped by region file, in on-disk index order
+ *   - region files are fsynced at most once per sync interval (and on flush)
+ *   - the edit journal (if any) is group-committed every commit interval and always
+ *     before a batch of snapshots is written
+ */
+class ChunkIOThread {
+public:
+    explicit ChunkIOThread(ChunkStorage* storage, int syncIntervalMs = DEFAULT_SYNC_INTERVAL_MS,
+                           EditJournal* journal = nullptr);
+    ~ChunkIOThread();
+
+    ChunkIOThread(const ChunkIOThread&) = delete;
+    ChunkIOThread& operator=(const ChunkIOThread&) = delete;
+
+    // Snapshot the chunk's blocks and queue them for writing
+    void queueSave(const Chunk& chunk);
+
+    // Copy a queued or in-flight snapshot so reloads see saves that have not reached disk yet
+    bool copyPending(ChunkCoord coord, BlockData* outBlocks);
+
+    // Block until every queued save is written and synced
+    void flush();
+
+    // Once every snapshot queued so far is written and synced, drop the retired journal file
+    // (call after EditJournal::rotate() and queueing snapshots of all modified chunks)
+    void requestJournalCompaction();
+
+    // fsync cadence
+    void setSyncInterval(int milliseconds);
+    int getSyncInterval() const { return static_cast<int>(syncInterval.load().count()); }
+
+    // Statistics
+    int getQueueDepth() const;
+    uint64_t getBytesWritten() const { return bytesWritten.load(); }
+    uint64_t getChunksWritten() const { return chunksWritten.load(); }
+    uint64_t getSavesCoalesced() const { return savesCoalesced.load(); }
+
+    static constexpr int DEFAULT_SYNC_INTERVAL_MS = 2000;
+    static constexpr int JOURNAL_COMMIT_INTERVAL_MS = 50;
+
+private:
+    using Snapshot = std::unique_ptr<BlockData[]>;
+    using SnapshotMap = std::unordered_map<ChunkCoord, Snapshot, ChunkCoord::Hash>;
+
+    ChunkStorage* storage;
+    EditJournal* journal;
+    std::thread worker;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable idleCondition;
+    SnapshotMap pending;              // Queued, newest snapshot per chunk
+    SnapshotMap writing;              // Batch currently being written
+    std::vector<Snapshot> freeBuffers; // Recycled snapshot buffers
+    bool stopRequested;
+    bool flushRequested;
+    bool unsyncedWrites;
+    bool compactionRequested;
+
+    std::atomic<std::chrono::milliseconds> syncInterval;
+    std::atomic<uint64_t> bytesWritten;
+    std::atomic<uint64_t> chunksWritten;
+    std::atomic<uint64_t> savesCoalesced;
+
+    static constexpr size_t MAX_FREE_BUFFERS = 16;
+
+    void run();
+    void writeBatch();
+};
@@ -0,0 +1,36 @@
+#include "chunk_pool.h"
+
+ChunkPool::ChunkPool(size_t capacity) : capacity(capacity), reused(0), created(0) {
+    freeChunks.reserve(capacity);
+}
+
+std::unique_ptr<Chunk> ChunkPool::acquire(ChunkCoord coord, World* world) {
+    if (freeChunks.empty()) {
+        created++;
+        return std::make_unique<Chunk>(coord, world);
+    }
+
+    std::unique_ptr<Chunk> chunk = std::move(freeChunks.back());
+    freeChunks.pop_back();
+    chunk->reset(coord);
+    reused++;
+    return chunk;
+}
+
+void ChunkPool::release(std::unique_ptr<Chunk> chunk) {
+    if (chunk && freeChunks.size() < capacity) {
+        freeChunks.push_back(std::move(chunk));
+    }
+}
+
+void ChunkPool::clear() {
+    freeChunks.clear();
+}
+
+size_t ChunkPool::getPooledBytes() const {
+    size_t bytes = 0;
+    for (const auto& chunk : freeChunks) {
+        bytes += chunk->getBlockBytes() + chunk->getGpuBytes();
+    }
+    return bytes;
+}
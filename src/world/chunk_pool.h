@@ -0,0 +1,44 @@
+#pragma once
+
+#include "chunk.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class World;
+
+/**
+ * @file chunk_pool.h
+ * @brief Free list of unloaded Chunk objects for reuse by later loads
+ *
+ * A Chunk owns 128 KB of block storage plus a VAO/VBO pair. Streaming would otherwise
+ * allocate, fill and create GL objects on every load and tear them all down on every
+ * unload. Pooled chunks keep their storage, GL handles and vertex buffer allocation;
+ * acquire() only resets their bookkeeping.
+ *
+ * Main (GL) thread only. clear() deletes GL objects, so call it while the context is alive.
+ */
+class ChunkPool {
+public:
+    explicit ChunkPool(size_t capacity = DEFAULT_CAPACITY);
+
+    // Recycled chunk if one is pooled, otherwise a newly constructed one
+    std::unique_ptr<Chunk> acquire(ChunkCoord coord, World* world);
+    // Keep the chunk for reuse (destroyed if the pool is full)
+    void release(std::unique_ptr<Chunk> chunk);
+    void clear();
+
+    // Statistics
+    size_t getPooledCount() const { return freeChunks.size(); }
+    size_t getPooledBytes() const;
+    uint64_t getReusedCount() const { return reused; }
+    uint64_t getCreatedCount() const { return created; }
+
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+private:
+    std::vector<std::unique_ptr<Chunk>> freeChunks;
+    size_t capacity;
+    uint64_t reused;
+    uint64_t created;
+};
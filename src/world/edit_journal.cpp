@@ -0,0 +1,306 @@
+#include "edit_journal.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static constexpr uint32_t JOURNAL_GROUP_MAGIC = 0x4C4E524A;   // "JRNL"
+static constexpr uint32_t JOURNAL_MAX_GROUP_RECORDS = 1u << 20;
+
+// Little-endian helpers so journals are portable between platforms
+static void writeU32(uint8_t* dst, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        dst[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+static uint32_t readU32(const uint8_t* src) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(src[i]) << (i * 8);
+    }
+    return value;
+}
+
+static void writeU64(uint8_t* dst, uint64_t value) {
+    writeU32(dst, static_cast<uint32_t>(value));
+    writeU32(dst + 4, static_cast<uint32_t>(value >> 32));
+}
+
+static uint64_t readU64(const uint8_t* src) {
+    return static_cast<uint64_t>(readU32(src)) | (static_cast<uint64_t>(readU32(src + 4)) << 32);
+}
+
+// FNV-1a over the record bytes of a group - enough to detect a torn tail
+static uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void syncFile(std::FILE* file) {
+    std::fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+// Record layout: min xyz (12) | max xyz (12) | old type, meta | new type, meta | op | 3 reserved | tick (8)
+static void encodeRecord(const JournalRecord& record, uint8_t* dst) {
+    std::memset(dst, 0, JOURNAL_RECORD_SIZE);
+    writeU32(dst, static_cast<uint32_t>(record.x));
+    writeU32(dst + 4, static_cast<uint32_t>(record.y));
+    writeU32(dst + 8, static_cast<uint32_t>(record.z));
+    writeU32(dst + 12, static_cast<uint32_t>(record.maxX));
+    writeU32(dst + 16, static_cast<uint32_t>(record.maxY));
+    writeU32(dst + 20, static_cast<uint32_t>(record.maxZ));
+    dst[24] = static_cast<uint8_t>(record.oldBlock.type);
+    dst[25] = record.oldBlock.metadata;
+    dst[26] = static_cast<uint8_t>(record.newBlock.type);
+    dst[27] = record.newBlock.metadata;
+    dst[28] = static_cast<uint8_t>(record.op);
+    writeU64(dst + 32, record.tick);
+}
+
+static bool decodeRecord(const uint8_t* src, JournalRecord& record) {
+    uint8_t count = static_cast<uint8_t>(BlockType::COUNT);
+    if (src[24] >= count || src[26] >= count || src[28] > static_cast<uint8_t>(JournalOp::FILL)) {
+        return false;
+    }
+
+    record.op = static_cast<JournalOp>(src[28]);
+    record.x = static_cast<int32_t>(readU32(src));
+    record.y = static_cast<int32_t>(readU32(src + 4));
+    record.z = static_cast<int32_t>(readU32(src + 8));
+    record.maxX = static_cast<int32_t>(readU32(src + 12));
+    record.maxY = static_cast<int32_t>(readU32(src + 16));
+    record.maxZ = static_cast<int32_t>(readU32(src + 20));
+    record.oldBlock = BlockData(static_cast<BlockType>(src[24]), src[25]);
+    record.newBlock = BlockData(static_cast<BlockType>(src[26]), src[27]);
+    record.tick = readU64(src + 32);
+    return true;
+}
+
+void JournalRecord::applyTo(ChunkCoord coord, BlockData* blocks) const {
+    using Geometry = CurrentChunkGeometry;
+
+    int baseX = Geometry::chunkToWorldX(coord.x);
+    int baseZ = Geometry::chunkToWorldZ(coord.z);
+    int x0 = std::max(x, baseX), x1 = std::min(maxX, baseX + Geometry::WIDTH - 1);
+    int z0 = std::max(z, baseZ), z1 = std::min(maxZ, baseZ + Geometry::DEPTH - 1);
+    int y0 = std::max(y, 0), y1 = std::min(maxY, Geometry::HEIGHT - 1);
+
+    for (int by = y0; by <= y1; by++) {
+        for (int bz = z0; bz <= z1; bz++) {
+            for (int bx = x0; bx <= x1; bx++) {
+                blocks[Geometry::blockIndex(bx - baseX, by, bz - baseZ)] = newBlock;
+            }
+        }
+    }
+}
+
+EditJournal::EditJournal(const std::string& path)
+    : path(path), retiredPath(path + ".old"), retirePending(false), retiredOnDisk(false),
+      committedBytes(0), file(nullptr) {
+    if (openCurrent()) {
+        std::fseek(file, 0, SEEK_END);
+        committedBytes = static_cast<uint64_t>(std::ftell(file));
+    }
+}
+
+EditJournal::~EditJournal() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool EditJournal::openCurrent() {
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) {
+        std::cerr << "Failed to open edit journal: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void EditJournal::append(const JournalRecord& record) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(record);
+}
+
+void EditJournal::commit() {
+    std::vector<JournalRecord> records;
+    std::vector<JournalRecord> retired;
+    bool retire;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.swap(pending);
+        retired.swap(retiring);
+        retire = retirePending;
+        retirePending = false;
+    }
+
+    if (records.empty() && !retire) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (!file) return;
+
+    if (retire) {
+        // Finish the old file, then move it aside; the rename is the compaction point
+        if (!retired.empty()) {
+            writeGroup(retired);
+        }
+        std::fclose(file);
+        file = nullptr;
+        std::remove(retiredPath.c_str());
+        if (std::rename(path.c_str(), retiredPath.c_str()) != 0) {
+            std::cerr << "Failed to retire edit journal: " << path << std::endl;
+        }
+        if (!openCurrent()) {
+            return;
+        }
+    }
+
+    if (!records.empty() && writeGroup(records)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        committedBytes += JOURNAL_GROUP_HEADER_SIZE + records.size() * JOURNAL_RECORD_SIZE;
+    }
+}
+
+bool EditJournal::writeGroup(const std::vector<JournalRecord>& records) {
+    std::vector<uint8_t> buffer(JOURNAL_GROUP_HEADER_SIZE + records.size() * JOURNAL_RECORD_SIZE);
+    uint8_t* body = buffer.data() + JOURNAL_GROUP_HEADER_SIZE;
+    for (size_t i = 0; i < records.size(); i++) {
+        encodeRecord(records[i], body + i * JOURNAL_RECORD_SIZE);
+    }
+
+    writeU32(buffer.data(), JOURNAL_GROUP_MAGIC);
+    writeU32(buffer.data() + 4, static_cast<uint32_t>(records.size()));
+    writeU32(buffer.data() + 8, checksum(body, records.size() * JOURNAL_RECORD_SIZE));
+
+    // One write and one fsync for the whole group
+    if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        std::cerr << "Failed to write edit journal: " << path << std::endl;
+        return false;
+    }
+    syncFile(file);
+    return true;
+}
+
+bool EditJournal::rotate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (retirePending || retiredOnDisk) {
+        return false;
+    }
+
+    retiring.swap(pending);
+    retirePending = true;
+    retiredOnDisk = true;
+    committedBytes = 0;
+    return true;
+}
+
+void EditJournal::dropRetired() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!retiredOnDisk || retirePending) {
+            return;
+        }
+        retiredOnDisk = false;
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    std::remove(retiredPath.c_str());
+}
+
+bool EditJournal::isCompacting() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return retirePending || retiredOnDisk;
+}
+
+void EditJournal::discard() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    removeFiles(path);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+    retiring.clear();
+    retirePending = false;
+    retiredOnDisk = false;
+    committedBytes = 0;
+}
+
+uint64_t EditJournal::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return committedBytes + pending.size() * JOURNAL_RECORD_SIZE;
+}
+
+size_t EditJournal::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending.size() + retiring.size();
+}
+
+size_t EditJournal::replay(const std::string& path, const std::function<void(const JournalRecord&)>& apply) {
+    size_t replayed = 0;
+
+    // The retired file holds older records than the current one
+    for (const std::string& filePath : {path + ".old", path}) {
+        std::FILE* input = std::fopen(filePath.c_str(), "rb");
+        if (!input) continue;
+
+        std::vector<uint8_t> body;
+        uint8_t header[JOURNAL_GROUP_HEADER_SIZE];
+        while (std::fread(header, 1, sizeof(header), input) == sizeof(header)) {
+            uint32_t count = readU32(header + 4);
+            if (readU32(header) != JOURNAL_GROUP_MAGIC || count == 0 || count > JOURNAL_MAX_GROUP_RECORDS) {
+                break;
+            }
+
+            body.resize(static_cast<size_t>(count) * JOURNAL_RECORD_SIZE);
+            if (std::fread(body.data(), 1, body.size(), input) != body.size() ||
+                checksum(body.data(), body.size()) != readU32(header + 8)) {
+                break;  // Torn tail from a crash mid-commit
+            }
+
+            std::vector<JournalRecord> records(count);
+            bool valid = true;
+            for (uint32_t i = 0; i < count && valid; i++) {
+                valid = decodeRecord(body.data() + i * JOURNAL_RECORD_SIZE, records[i]);
+            }
+            if (!valid) {
+                break;
+            }
+
+            for (const JournalRecord& record : records) {
+                apply(record);
+            }
+            replayed += count;
+        }
+
+        std::fclose(input);
+    }
+
+    return replayed;
+}
+
+void EditJournal::removeFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".old").c_str());
+}
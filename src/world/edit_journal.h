@@ -0,0 +1,114 @@
+#pragma once
+
+#include "chunk.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file edit_journal.h
+ * @brief Append-only write-ahead journal of player block edits
+ *
+ * Every World::setBlock appends a small record (bulk fills append one box record per
+ * affected chunk); the chunk I/O thread group-commits the buffered records (one write +
+ * fsync per commit interval) so clicks are durable without rewriting whole chunks.
+ *
+ * Records are always committed before any chunk snapshot reaches a region file, so a
+ * snapshot can already contain a prefix of the journal. Replay is still correct because
+ * every record writes absolute values: re-applying a prefix and then the rest, in order,
+ * ends in the same state. Conditional edits (replaceRegion, pasteRegion) must therefore
+ * be journaled as SET_BLOCK records for the blocks they actually changed - a "replace A
+ * with B" record replayed over a later snapshot would also hit blocks that only became A
+ * afterwards.
+ *
+ * File layout: a sequence of commit groups, each
+ *   magic (4) | record count (4) | checksum (4) | records (JOURNAL_RECORD_SIZE each)
+ * A torn or corrupt group at the tail (crash mid-commit) ends replay.
+ *
+ * Compaction: rotate() retires the current file; once the chunk snapshots queued at the same
+ * time are written and synced, dropRetired() deletes it. This keeps replay time bounded.
+ */
+
+enum class JournalOp : uint8_t {
+    SET_BLOCK = 0,  // One block: oldBlock -> newBlock
+    FILL = 1        // Every block in the box becomes newBlock
+};
+
+struct JournalRecord {
+    JournalOp op;
+    int32_t x, y, z;            // World block position (box minimum for FILL)
+    int32_t maxX, maxY, maxZ;   // Inclusive box maximum (same as x, y, z for SET_BLOCK)
+    BlockData oldBlock;
+    BlockData newBlock;
+    uint64_t tick;              // World edit counter, increases monotonically
+
+    static JournalRecord setBlock(int x, int y, int z, BlockData oldBlock, BlockData newBlock, uint64_t tick) {
+        return JournalRecord{JournalOp::SET_BLOCK, x, y, z, x, y, z, oldBlock, newBlock, tick};
+    }
+    static JournalRecord fill(const glm::ivec3& minCorner, const glm::ivec3& maxCorner, BlockData block, uint64_t tick) {
+        return JournalRecord{JournalOp::FILL, minCorner.x, minCorner.y, minCorner.z,
+                             maxCorner.x, maxCorner.y, maxCorner.z, BlockData(), block, tick};
+    }
+
+    // Write the part of the record that falls inside one chunk's raw block array
+    void applyTo(ChunkCoord coord, BlockData* blocks) const;
+};
+
+constexpr size_t JOURNAL_RECORD_SIZE = 40;
+constexpr size_t JOURNAL_GROUP_HEADER_SIZE = 12;
+
+class EditJournal {
+public:
+    explicit EditJournal(const std::string& path);
+    ~EditJournal();
+
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    const std::string& getPath() const { return path; }
+
+    // Main thread - buffer a record for the next group commit
+    void append(const JournalRecord& record);
+
+    // I/O thread - write and fsync everything appended so far (no-op when nothing is buffered)
+    void commit();
+
+    // Start a compaction; records appended from now on go to a fresh file
+    // Returns false while a previous compaction is still in flight
+    bool rotate();
+    // Delete the retired file once the snapshots covering it are synced
+    void dropRetired();
+    bool isCompacting() const;
+
+    // Remove all journal files (every edit is already in the region files)
+    void discard();
+
+    // Bytes committed to the current file plus records still buffered
+    uint64_t getSize() const;
+    size_t getPendingCount() const;
+
+    // Read the retired file (if a compaction was interrupted) then the current file, in order
+    // Returns the number of records replayed
+    static size_t replay(const std::string& path, const std::function<void(const JournalRecord&)>& apply);
+    static void removeFiles(const std::string& path);
+
+private:
+    std::string path;
+    std::string retiredPath;
+
+    mutable std::mutex mutex;               // Guards the buffers and flags below
+    std::vector<JournalRecord> pending;     // Appended since the last commit
+    std::vector<JournalRecord> retiring;    // Belong to the file being retired
+    bool retirePending;
+    bool retiredOnDisk;
+    uint64_t committedBytes;
+
+    std::mutex fileMutex;                   // Serializes file operations (I/O thread and discard)
+    std::FILE* file;
+
+    bool openCurrent();
+    bool writeGroup(const std::vector<JournalRecord>& records);
+};
@@ -0,0 +1,285 @@
+#include "far_terrain.h"
+#include "chunk.h"
+#include "world.h"
+#include <algorithm>
+#include <cmath>
+
+FarTerrain::FarTerrain()
+    : levelCount(DEFAULT_LEVELS), initialized(false), holeCenter(0.0f), holeRadius(0.0f), heightSamples(0) {
+    levels.resize(MAX_LEVELS);
+    for (int i = 0; i < MAX_LEVELS; i++) {
+        levels[i].spacing = BASE_SPACING << i;
+    }
+}
+
+FarTerrain::~FarTerrain() {
+    shutdown();
+}
+
+void FarTerrain::initialize() {
+    if (initialized) return;
+    for (Level& level : levels) {
+        glGenVertexArrays(1, &level.VAO);
+        glGenBuffers(1, &level.VBO);
+        level.meshDirty = true;
+    }
+    initialized = true;
+}
+
+void FarTerrain::shutdown() {
+    if (!initialized) return;
+    for (Level& level : levels) {
+        if (level.VBO != 0) {
+            glDeleteBuffers(1, &level.VBO);
+            level.VBO = 0;
+        }
+        if (level.VAO != 0) {
+            glDeleteVertexArrays(1, &level.VAO);
+            level.VAO = 0;
+        }
+        level.vertexCount = 0;
+        level.bufferCapacity = 0;
+        level.sampled = false;
+        level.heights.clear();
+    }
+    initialized = false;
+}
+
+void FarTerrain::setLevelCount(int count) {
+    count = std::max(1, std::min(MAX_LEVELS, count));
+    if (count == levelCount) return;
+
+    // The outermost level is the only one without stitched outlines, so all levels rebuild
+    levelCount = count;
+    for (Level& level : levels) {
+        level.meshDirty = true;
+    }
+}
+
+float FarTerrain::getRadius() const {
+    return static_cast<float>((GRID_CELLS / 2) * (BASE_SPACING << (levelCount - 1)));
+}
+
+size_t FarTerrain::getVertexCount() const {
+    size_t total = 0;
+    for (int i = 0; i < levelCount; i++) {
+        total += levels[i].vertexCount;
+    }
+    return total;
+}
+
+size_t FarTerrain::getGpuBytes() const {
+    size_t total = 0;
+    for (const Level& level : levels) {
+        total += level.bufferCapacity;
+    }
+    return total;
+}
+
+void FarTerrain::update(const glm::vec3& playerPos, float innerRadius) {
+    if (!initialized) return;
+
+    glm::vec2 player(playerPos.x, playerPos.z);
+    for (int i = 0; i < levelCount; i++) {
+        Level& level = levels[i];
+
+        // Snapping to twice the spacing puts the outline on the parent level's grid lines
+        float snap = static_cast<float>(level.spacing * 2);
+        glm::vec2 corner = player - static_cast<float>((GRID_CELLS / 2) * level.spacing);
+        glm::ivec2 origin(static_cast<int>(std::floor(corner.x / snap) * snap),
+                          static_cast<int>(std::floor(corner.y / snap) * snap));
+
+        if (!level.sampled || origin != level.origin) {
+            recenter(level, origin);
+            level.meshDirty = true;
+            if (i + 1 < levelCount) {
+                levels[i + 1].meshDirty = true;  // Its hole follows this level
+            }
+        }
+    }
+
+    // The hole for the loaded chunks moves with the finest level. A new radius changes
+    // every level; a move only matters to levels the hole reaches past their inner level.
+    if (innerRadius != holeRadius) {
+        holeCenter = player;
+        holeRadius = innerRadius;
+        for (int i = 0; i < levelCount; i++) {
+            levels[i].meshDirty = true;
+        }
+    } else if (levels[0].meshDirty) {
+        glm::vec2 oldCenter = holeCenter;
+        holeCenter = player;
+        for (int i = 1; i < levelCount; i++) {
+            if (!levels[i].meshDirty &&
+                (!holeInside(levels[i - 1], oldCenter) || !holeInside(levels[i - 1], holeCenter))) {
+                levels[i].meshDirty = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < levelCount; i++) {
+        if (levels[i].meshDirty) {
+            buildMesh(i);
+        }
+    }
+}
+
+void FarTerrain::invalidate() {
+    for (Level& level : levels) {
+        level.sampled = false;
+        level.heights.clear();
+        level.meshDirty = true;
+    }
+}
+
+bool FarTerrain::holeInside(const Level& level, const glm::vec2& center) const {
+    float size = static_cast<float>(GRID_CELLS * level.spacing);
+    glm::vec2 minCorner(level.origin);
+    return center.x - holeRadius >= minCorner.x && center.x + holeRadius <= minCorner.x + size &&
+           center.y - holeRadius >= minCorner.y && center.y + holeRadius <= minCorner.y + size;
+}
+
+void FarTerrain::recenter(Level& level, const glm::ivec2& origin) {
+    std::vector<int> heights(GRID_SAMPLES * GRID_SAMPLES);
+    glm::ivec2 shift = (origin - level.origin) / level.spacing;
+
+    for (int z = 0; z < GRID_SAMPLES; z++) {
+        for (int x = 0; x < GRID_SAMPLES; x++) {
+            int oldX = x + shift.x;
+            int oldZ = z + shift.y;
+            if (level.sampled && oldX >= 0 && oldX < GRID_SAMPLES && oldZ >= 0 && oldZ < GRID_SAMPLES) {
+                heights[z * GRID_SAMPLES + x] = level.heights[oldZ * GRID_SAMPLES + oldX];
+            } else {
+                heights[z * GRID_SAMPLES + x] = Chunk::getColumnHeight(origin.x + x * level.spacing,
+                                                                      origin.y + z * level.spacing);
+                heightSamples++;
+            }
+        }
+    }
+
+    level.heights.swap(heights);
+    level.origin = origin;
+    level.sampled = true;
+}
+
+float FarTerrain::vertexHeight(const Level& level, bool stitch, int x, int z) const {
+    auto surface = [&](int sampleX, int sampleZ) {
+        int height = std::max(level.heights[sampleZ * GRID_SAMPLES + sampleX], gTerrainSettings.waterLevel);
+        return static_cast<float>(height + 1) - SURFACE_DROP;
+    };
+
+    // Odd outline vertices fall mid-edge on the parent level, so use the edge's height there
+    if (stitch) {
+        bool edgeX = x == 0 || x == GRID_CELLS;
+        bool edgeZ = z == 0 || z == GRID_CELLS;
+        if (edgeX && (z & 1)) {
+            return 0.5f * (surface(x, z - 1) + surface(x, z + 1));
+        }
+        if (edgeZ && (x & 1)) {
+            return 0.5f * (surface(x - 1, z) + surface(x + 1, z));
+        }
+    }
+    return surface(x, z);
+}
+
+void FarTerrain::buildMesh(size_t levelIndex) {
+    Level& level = levels[levelIndex];
+    const Level* inner = levelIndex > 0 ? &levels[levelIndex - 1] : nullptr;
+    bool stitch = static_cast<int>(levelIndex) + 1 < levelCount;
+    const float spacing = static_cast<float>(level.spacing);
+    const float textureSize = 1.0f / BlockRegistry::TEXTURES_PER_ROW;
+
+    std::vector<float>& vertices = meshScratch;
+    vertices.clear();
+
+    auto normalAt = [&](int x, int z) {
+        float left = vertexHeight(level, false, std::max(x - 1, 0), z);
+        float right = vertexHeight(level, false, std::min(x + 1, GRID_CELLS), z);
+        float down = vertexHeight(level, false, x, std::max(z - 1, 0));
+        float up = vertexHeight(level, false, x, std::min(z + 1, GRID_CELLS));
+        return glm::normalize(glm::vec3(left - right, 2.0f * spacing, down - up));
+    };
+
+    for (int cellZ = 0; cellZ < GRID_CELLS; cellZ++) {
+        for (int cellX = 0; cellX < GRID_CELLS; cellX++) {
+            float x0 = static_cast<float>(level.origin.x) + cellX * spacing;
+            float z0 = static_cast<float>(level.origin.y) + cellZ * spacing;
+
+            // Skip cells the finer level covers, and cells entirely within the loaded chunks
+            if (inner) {
+                float innerMinX = static_cast<float>(inner->origin.x);
+                float innerMinZ = static_cast<float>(inner->origin.y);
+                float innerSize = static_cast<float>(GRID_CELLS * inner->spacing);
+                if (x0 >= innerMinX && x0 + spacing <= innerMinX + innerSize &&
+                    z0 >= innerMinZ && z0 + spacing <= innerMinZ + innerSize) {
+                    continue;
+                }
+            }
+            float farX = std::max(std::abs(x0 - holeCenter.x), std::abs(x0 + spacing - holeCenter.x));
+            float farZ = std::max(std::abs(z0 - holeCenter.y), std::abs(z0 + spacing - holeCenter.y));
+            if (farX * farX + farZ * farZ <= holeRadius * holeRadius) {
+                continue;
+            }
+
+            // One atlas tile per cell (the surface type at its first corner), sampled at the
+            // tile centre so interpolation never reaches a neighbouring tile
+            int height = level.heights[cellZ * GRID_SAMPLES + cellX];
+            BlockType type = height < gTerrainSettings.waterLevel ? BlockType::WATER : Chunk::getSurfaceType(height);
+            glm::vec2 uv = BlockRegistry::getBlock(type).getTextureCoords(static_cast<int>(CubeFace::TOP)) +
+                           glm::vec2(textureSize * 0.5f);
+
+            // Two counter-clockwise (seen from above) triangles: 00-01-11 and 00-11-10
+            static const int CORNERS[6][2] = {{0, 0}, {0, 1}, {1, 1}, {0, 0}, {1, 1}, {1, 0}};
+            for (const auto& corner : CORNERS) {
+                int x = cellX + corner[0];
+                int z = cellZ + corner[1];
+                glm::vec3 normal = normalAt(x, z);
+                vertices.push_back(x0 + corner[0] * spacing);
+                vertices.push_back(vertexHeight(level, stitch, x, z));
+                vertices.push_back(z0 + corner[1] * spacing);
+                vertices.push_back(normal.x);
+                vertices.push_back(normal.y);
+                vertices.push_back(normal.z);
+                vertices.push_back(uv.x);
+                vertices.push_back(uv.y);
+            }
+        }
+    }
+
+    level.vertexCount = vertices.size() / VERTEX_FLOATS;
+    level.meshDirty = false;
+    if (level.vertexCount == 0) {
+        return;
+    }
+
+    glBindVertexArray(level.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, level.VBO);
+    size_t meshBytes = vertices.size() * sizeof(float);
+    if (meshBytes > level.bufferCapacity) {
+        glBufferData(GL_ARRAY_BUFFER, meshBytes, vertices.data(), GL_DYNAMIC_DRAW);
+        level.bufferCapacity = meshBytes;
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, meshBytes, vertices.data());
+    }
+
+    // World-space position, smooth normal and atlas UV (shaders/far_terrain.vert)
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, VERTEX_FLOATS * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, VERTEX_FLOATS * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, VERTEX_FLOATS * sizeof(float), (void*)(6 * sizeof(float)));
+    glBindVertexArray(0);
+}
+
+void FarTerrain::submitDraws(RenderQueue& queue, const RenderQueue::DrawState& state) const {
+    if (!initialized) return;
+    for (int i = 0; i < levelCount; i++) {
+        const Level& level = levels[i];
+        if (level.vertexCount == 0) continue;
+        // Opaque, so sorted front to back by the level's inner edge: finer rings draw first
+        float distance = static_cast<float>((GRID_CELLS / 2) * (level.spacing / 2));
+        distance = std::max(distance, holeRadius);
+        queue.submit(state, level.VAO, 0, static_cast<GLsizei>(level.vertexCount), glm::ivec2(0), distance);
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "../renderer/render_queue.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file far_terrain.h
+ * @brief Heightmap clipmap that extends the horizon beyond the loaded chunks
+ *
+ * Nested square levels of GRID_CELLS x GRID_CELLS cells; level n samples the generator's
+ * height field (Chunk::getColumnHeight) every BASE_SPACING << n blocks and is coloured by the
+ * generator's surface type, so no block chunks are generated for it. Each level leaves a hole
+ * where the next finer level lies, and no level draws cells entirely within the loaded chunks.
+ *
+ * Level origins snap to the next coarser level's spacing, so every level's outline lies on
+ * its parent's grid lines; the odd vertices along each outline take the average of their
+ * neighbours so that they sit on the parent's edges without cracks.
+ *
+ * As the player moves, a level is re-centred only when it crosses its snap grid, and only
+ * the samples that scrolled into view are taken from the height field. Only that level and
+ * the next one out (whose hole follows it) are rebuilt.
+ */
+class FarTerrain {
+public:
+    static constexpr int GRID_CELLS = 64;       // Cells per level side (even)
+    static constexpr int BASE_SPACING = 8;      // Blocks between level 0 samples
+    static constexpr int MAX_LEVELS = 5;
+    static constexpr int DEFAULT_LEVELS = 3;
+    // Far terrain sits this far below the real surface so it never pokes through chunks
+    static constexpr float SURFACE_DROP = 2.0f;
+
+    FarTerrain();
+    ~FarTerrain();
+
+    FarTerrain(const FarTerrain&) = delete;
+    FarTerrain& operator=(const FarTerrain&) = delete;
+
+    void initialize();
+    void shutdown();
+
+    int getLevelCount() const { return levelCount; }
+    void setLevelCount(int levels);
+
+    // Re-centre on the player; cells within innerRadius blocks of the player are left to
+    // the loaded chunks
+    void update(const glm::vec3& playerPos, float innerRadius);
+    // Drop every height sample (the generator changed, e.g. a new seed); the next update
+    // resamples and rebuilds all levels
+    void invalidate();
+
+    // Queue each level for drawing (vertices are in world space, for shaders/far_terrain.vert)
+    void submitDraws(RenderQueue& queue, const RenderQueue::DrawState& state) const;
+
+    // Distance from the centre to the edge of the outermost level, in blocks
+    float getRadius() const;
+
+    // Statistics
+    size_t getVertexCount() const;
+    size_t getGpuBytes() const;
+    size_t getHeightSamples() const { return heightSamples; }   // Height field samples taken
+
+private:
+    struct Level {
+        int spacing = 0;
+        glm::ivec2 origin = glm::ivec2(0);  // World block position of sample (0, 0)
+        bool sampled = false;
+        bool meshDirty = true;
+        std::vector<int> heights;           // (GRID_CELLS + 1)^2 samples, row-major in z
+        GLuint VAO = 0;
+        GLuint VBO = 0;
+        size_t vertexCount = 0;
+        size_t bufferCapacity = 0;
+    };
+
+    std::vector<Level> levels;
+    int levelCount;
+    bool initialized;
+    glm::vec2 holeCenter;
+    float holeRadius;
+    size_t heightSamples;
+    std::vector<float> meshScratch;
+
+    static constexpr int GRID_SAMPLES = GRID_CELLS + 1;
+    // Position(3) + Normal(3) + TexCoord(2) - slopes need real normals, unlike block faces
+    static constexpr int VERTEX_FLOATS = 8;
+
+    // Move a level to a new origin, keeping the samples that overlap the old one
+    void recenter(Level& level, const glm::ivec2& origin);
+    void buildMesh(size_t levelIndex);
+    // Whether the loaded-chunk hole around center lies entirely within a level's square
+    bool holeInside(const Level& level, const glm::vec2& center) const;
+    // Sample height, with odd outline vertices averaged onto the parent level's edges
+    float vertexHeight(const Level& level, bool stitch, int x, int z) const;
+};
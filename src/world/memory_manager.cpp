@@ -0,0 +1,60 @@
+#include "memory_manager.h"
+#include <algorithm>
+
+MemoryManager::MemoryManager(size_t budgetBytes)
+    : budget(budgetBytes), blockBytes(0), gpuBytes(0), cacheBytes(0), poolBytes(0), meshBytes(0) {
+}
+
+void MemoryManager::trackChunk(const Chunk& chunk) {
+    ChunkMemory& usage = chunkUsage[chunk.getCoord()];
+    blockBytes -= usage.blockBytes;
+    gpuBytes -= usage.gpuBytes;
+
+    usage.blockBytes = chunk.getBlockBytes();
+    usage.gpuBytes = chunk.getGpuBytes();
+    blockBytes += usage.blockBytes;
+    gpuBytes += usage.gpuBytes;
+}
+
+void MemoryManager::untrackChunk(ChunkCoord coord) {
+    auto it = chunkUsage.find(coord);
+    if (it == chunkUsage.end()) return;
+
+    blockBytes -= it->second.blockBytes;
+    gpuBytes -= it->second.gpuBytes;
+    chunkUsage.erase(it);
+}
+
+void MemoryManager::clear() {
+    chunkUsage.clear();
+    blockBytes = 0;
+    gpuBytes = 0;
+}
+
+std::vector<ChunkCoord> MemoryManager::selectEvictions(const glm::vec3& playerPos, float keepDistance) const {
+    std::vector<ChunkCoord> victims;
+    size_t total = getTotalBytes();
+    size_t target = getLowWaterBytes();
+    if (total <= target) {
+        return victims;
+    }
+
+    std::vector<std::pair<float, ChunkCoord>> byDistance;
+    byDistance.reserve(chunkUsage.size());
+    for (const auto& pair : chunkUsage) {
+        float distance = ChunkUtils::chunkDistanceToPoint(pair.first, playerPos);
+        if (distance > keepDistance) {
+            byDistance.emplace_back(distance, pair.first);
+        }
+    }
+    std::sort(byDistance.begin(), byDistance.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    for (const auto& entry : byDistance) {
+        if (total <= target) break;
+        total -= chunkUsage.at(entry.second).total();
+        victims.push_back(entry.second);
+    }
+    return victims;
+}
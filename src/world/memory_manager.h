@@ -0,0 +1,75 @@
+#pragma once
+
+#include "chunk.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @file memory_manager.h
+ * @brief Resident-memory accounting for loaded chunks against a global budget
+ *
+ * Tracks, per loaded chunk, the bytes of block storage and of its GPU vertex buffer, plus
+ * shared overheads: the compressed bytes held by the unloaded-chunk cache, pooled chunks
+ * waiting for reuse and the CPU mesh scratch buffer. World asks for evictions when the
+ * total goes over budget; chunks are picked farthest from the player first until the total
+ * would drop below the low-water mark (so eviction does not trigger again next frame).
+ * Chunks the player needs are never picked, even if the budget cannot be met without them.
+ */
+
+struct ChunkMemory {
+    size_t blockBytes = 0;
+    size_t gpuBytes = 0;
+
+    size_t total() const { return blockBytes + gpuBytes; }
+};
+
+class MemoryManager {
+public:
+    explicit MemoryManager(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+
+    // (Re)record a loaded chunk's footprint - call after loading and after each remesh
+    void trackChunk(const Chunk& chunk);
+    void untrackChunk(ChunkCoord coord);
+    void clear();
+
+    // Compressed bytes currently held by the unloaded-chunk cache
+    void setCacheBytes(size_t bytes) { cacheBytes = bytes; }
+    // Chunks held by the chunk pool, and the shared CPU mesh scratch
+    void setPoolBytes(size_t bytes) { poolBytes = bytes; }
+    void setMeshBytes(size_t bytes) { meshBytes = bytes; }
+
+    void setBudget(size_t bytes) { budget = bytes; }
+    size_t getBudget() const { return budget; }
+    size_t getLowWaterBytes() const { return static_cast<size_t>(budget * LOW_WATER_FRACTION); }
+
+    // Totals
+    size_t getBlockBytes() const { return blockBytes; }
+    size_t getGpuBytes() const { return gpuBytes; }
+    size_t getCacheBytes() const { return cacheBytes; }
+    size_t getPoolBytes() const { return poolBytes; }
+    size_t getMeshBytes() const { return meshBytes; }
+    size_t getChunkBytes() const { return blockBytes + gpuBytes; }
+    // Memory that eviction of loaded chunks cannot give back
+    size_t getFixedBytes() const { return poolBytes + meshBytes; }
+    size_t getTotalBytes() const { return blockBytes + gpuBytes + cacheBytes + poolBytes + meshBytes; }
+    bool isOverBudget() const { return getTotalBytes() > budget; }
+
+    // Loaded chunks to evict, farthest from the player first, to get back under the low-water
+    // mark. Chunks within keepDistance of the player (ChunkUtils::chunkDistanceToPoint) are
+    // kept, so the list can fall short of the mark.
+    std::vector<ChunkCoord> selectEvictions(const glm::vec3& playerPos, float keepDistance) const;
+
+    static constexpr size_t DEFAULT_BUDGET_BYTES = static_cast<size_t>(1536) * 1024 * 1024;
+    static constexpr float LOW_WATER_FRACTION = 0.85f;
+
+private:
+    std::unordered_map<ChunkCoord, ChunkMemory, ChunkCoord::Hash> chunkUsage;
+    size_t budget;
+    size_t blockBytes;
+    size_t gpuBytes;
+    size_t cacheBytes;
+    size_t poolBytes;
+    size_t meshBytes;
+};
@@ -0,0 +1,765 @@
+#include "region_file.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Little-endian helpers so region files are portable between platforms
+static void writeU32(uint8_t* dst, uint32_t value) {
+    dst[0] = static_cast<uint8_t>(value);
+    dst[1] = static_cast<uint8_t>(value >> 8);
+    dst[2] = static_cast<uint8_t>(value >> 16);
+    dst[3] = static_cast<uint8_t>(value >> 24);
+}
+
+static uint32_t readU32(const uint8_t* src) {
+    return static_cast<uint32_t>(src[0]) |
+           (static_cast<uint32_t>(src[1]) << 8) |
+           (static_cast<uint32_t>(src[2]) << 16) |
+           (static_cast<uint32_t>(src[3]) << 24);
+}
+
+// Floor division for region coordinates
+static int floorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+RegionFile::RegionFile(const std::string& path)
+    : path(path), file(nullptr), unflushedWrites(false), mappedData(nullptr), mappedSize(0)
+#ifdef _WIN32
+    , mappingHandle(nullptr)
+#endif
+{
+    locations.fill(0);
+
+    // Open existing file for update, or create a new one
+    file = std::fopen(path.c_str(), "r+b");
+    if (!file) {
+        file = std::fopen(path.c_str(), "w+b");
+    }
+
+    if (!file) {
+        std::cerr << "Failed to open region file: " << path << std::endl;
+        return;
+    }
+
+    if (!loadHeader()) {
+        std::cerr << "Corrupt region file header, ignoring contents: " << path << std::endl;
+        std::fclose(file);
+        file = std::fopen(path.c_str(), "w+b");
+        locations.fill(0);
+        if (file) {
+            loadHeader();
+        }
+    }
+}
+
+RegionFile::~RegionFile() {
+    unmap();
+    if (file) {
+        std::fflush(file);
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool RegionFile::loadHeader() {
+    std::fseek(file, 0, SEEK_END);
+    long fileSize = std::ftell(file);
+
+    // New file - write an empty location table
+    if (fileSize < REGION_SECTOR_SIZE * REGION_HEADER_SECTORS) {
+        std::vector<uint8_t> header(REGION_SECTOR_SIZE * REGION_HEADER_SECTORS, 0);
+        std::fseek(file, 0, SEEK_SET);
+        if (std::fwrite(header.data(), 1, header.size(), file) != header.size()) {
+            return false;
+        }
+        std::fflush(file);
+        usedSectors.assign(REGION_HEADER_SECTORS, true);
+        return true;
+    }
+
+    uint8_t header[REGION_SECTOR_SIZE];
+    std::fseek(file, 0, SEEK_SET);
+    if (std::fread(header, 1, sizeof(header), file) != sizeof(header)) {
+        return false;
+    }
+
+    size_t totalSectors = static_cast<size_t>((fileSize + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    usedSectors.assign(totalSectors, false);
+    for (int i = 0; i < REGION_HEADER_SECTORS; i++) {
+        usedSectors[i] = true;
+    }
+
+    for (int i = 0; i < REGION_CHUNK_COUNT; i++) {
+        uint32_t location = readU32(header + i * 4);
+        uint32_t offset = sectorOffset(location);
+        uint32_t count = sectorCount(location);
+
+        // Drop entries that point outside the file or into the header
+        if (location != 0 &&
+            (offset < static_cast<uint32_t>(REGION_HEADER_SECTORS) || count == 0 || offset + count > totalSectors)) {
+            location = 0;
+        }
+
+        locations[i] = location;
+        for (uint32_t s = 0; location != 0 && s < count; s++) {
+            usedSectors[offset + s] = true;
+        }
+    }
+
+    return true;
+}
+
+bool RegionFile::hasChunk(int localX, int localZ) const {
+    return locations[localIndex(localX, localZ)] != 0;
+}
+
+bool RegionFile::readChunk(int localX, int localZ, std::vector<uint8_t>& payload, RegionCompression& compression) {
+    if (!file) return false;
+
+    uint32_t location = locations[localIndex(localX, localZ)];
+    if (location == 0) {
+        return false;
+    }
+
+    // Read the whole sector run in one aligned read
+    size_t runBytes = static_cast<size_t>(sectorCount(location)) * REGION_SECTOR_SIZE;
+    payload.resize(runBytes);
+    std::fseek(file, static_cast<long>(sectorOffset(location)) * REGION_SECTOR_SIZE, SEEK_SET);
+    if (std::fread(payload.data(), 1, runBytes, file) != runBytes) {
+        return false;
+    }
+
+    uint32_t length = readU32(payload.data());
+    if (length + REGION_PAYLOAD_HEADER_SIZE > runBytes) {
+        return false;
+    }
+
+    compression = static_cast<RegionCompression>(payload[4]);
+    payload.erase(payload.begin(), payload.begin() + REGION_PAYLOAD_HEADER_SIZE);
+    payload.resize(length);
+    return true;
+}
+
+bool RegionFile::mapChunk(int localX, int localZ, const uint8_t*& payload, size_t& size, RegionCompression& compression) {
+    if (!file) return false;
+
+    uint32_t location = locations[localIndex(localX, localZ)];
+    if (location == 0) {
+        return false;
+    }
+
+    size_t runStart = static_cast<size_t>(sectorOffset(location)) * REGION_SECTOR_SIZE;
+    size_t runBytes = static_cast<size_t>(sectorCount(location)) * REGION_SECTOR_SIZE;
+
+    // The stream may still hold this payload, and a grown file needs a larger mapping
+    if (unflushedWrites) {
+        std::fflush(file);
+        unflushedWrites = false;
+    }
+    if (runStart + runBytes > mappedSize && (!remap() || runStart + runBytes > mappedSize)) {
+        return false;
+    }
+
+    const uint8_t* run = mappedData + runStart;
+    uint32_t length = readU32(run);
+    if (length + REGION_PAYLOAD_HEADER_SIZE > runBytes) {
+        return false;
+    }
+
+    compression = static_cast<RegionCompression>(run[4]);
+    payload = run + REGION_PAYLOAD_HEADER_SIZE;
+    size = length;
+    return true;
+}
+
+void RegionFile::prefetchChunk(int localX, int localZ) {
+    if (!file) return;
+
+    uint32_t location = locations[localIndex(localX, localZ)];
+    if (location == 0) {
+        return;
+    }
+
+    size_t runStart = static_cast<size_t>(sectorOffset(location)) * REGION_SECTOR_SIZE;
+    size_t runBytes = static_cast<size_t>(sectorCount(location)) * REGION_SECTOR_SIZE;
+    if (runStart + runBytes > mappedSize && (!remap() || runStart + runBytes > mappedSize)) {
+        return;
+    }
+
+#ifndef _WIN32
+    // madvise wants a page-aligned address; pages may be larger than a sector
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t alignedStart = runStart - runStart % pageSize;
+    madvise(const_cast<uint8_t*>(mappedData) + alignedStart, runStart + runBytes - alignedStart, MADV_WILLNEED);
+#endif
+}
+
+bool RegionFile::remap() {
+    unmap();
+    if (!file) return false;
+
+    std::fflush(file);
+    unflushedWrites = false;
+
+#ifdef _WIN32
+    HANDLE fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    LARGE_INTEGER fileSize;
+    if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    mappingHandle = mapping;
+    mappedData = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    struct stat info;
+    if (fstat(fileno(file), &info) != 0 || info.st_size == 0) {
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    mappedData = static_cast<const uint8_t*>(view);
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void RegionFile::unmap() {
+    if (!mappedData) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mappedData);
+    CloseHandle(mappingHandle);
+    mappingHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+bool RegionFile::writeChunk(int localX, int localZ, const uint8_t* data, size_t size, RegionCompression compression) {
+    if (!file) return false;
+
+    size_t totalBytes = size + REGION_PAYLOAD_HEADER_SIZE;
+    int sectorsNeeded = static_cast<int>((totalBytes + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    if (sectorsNeeded > REGION_MAX_CHUNK_SECTORS) {
+        std::cerr << "Chunk payload too large for region file (" << size << " bytes)" << std::endl;
+        return false;
+    }
+
+    int index = localIndex(localX, localZ);
+    int firstSector = allocateSectors(index, sectorsNeeded);
+
+    // Assemble a sector-aligned buffer so the write never leaves a partial sector behind
+    std::vector<uint8_t> buffer(static_cast<size_t>(sectorsNeeded) * REGION_SECTOR_SIZE, 0);
+    writeU32(buffer.data(), static_cast<uint32_t>(size));
+    buffer[4] = static_cast<uint8_t>(compression);
+    std::memcpy(buffer.data() + REGION_PAYLOAD_HEADER_SIZE, data, size);
+
+    std::fseek(file, static_cast<long>(firstSector) * REGION_SECTOR_SIZE, SEEK_SET);
+    unflushedWrites = true;
+    if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        return false;
+    }
+
+    locations[index] = (static_cast<uint32_t>(firstSector) << 8) | static_cast<uint32_t>(sectorsNeeded);
+    return writeLocation(index);
+}
+
+bool RegionFile::removeChunk(int localX, int localZ) {
+    if (!file) return false;
+
+    int index = localIndex(localX, localZ);
+    uint32_t location = locations[index];
+    if (location == 0) {
+        return true;
+    }
+
+    for (uint32_t s = 0; s < sectorCount(location); s++) {
+        usedSectors[sectorOffset(location) + s] = false;
+    }
+
+    locations[index] = 0;
+    return writeLocation(index);
+}
+
+int RegionFile::allocateSectors(int index, int sectorCountNeeded) {
+    uint32_t location = locations[index];
+    uint32_t oldOffset = sectorOffset(location);
+    uint32_t oldCount = sectorCount(location);
+
+    // Rewrite in place when the new payload fits in the old run
+    if (location != 0 && static_cast<uint32_t>(sectorCountNeeded) <= oldCount) {
+        for (uint32_t s = sectorCountNeeded; s < oldCount; s++) {
+            usedSectors[oldOffset + s] = false;
+        }
+        return static_cast<int>(oldOffset);
+    }
+
+    // Release the old run before searching so it can be reused if it grows into free space
+    for (uint32_t s = 0; location != 0 && s < oldCount; s++) {
+        usedSectors[oldOffset + s] = false;
+    }
+
+    // First-fit search for a free run
+    int runStart = 0;
+    int runLength = 0;
+    for (int s = REGION_HEADER_SECTORS; s < static_cast<int>(usedSectors.size()); s++) {
+        if (usedSectors[s]) {
+            runLength = 0;
+            continue;
+        }
+        if (runLength == 0) {
+            runStart = s;
+        }
+        if (++runLength == sectorCountNeeded) {
+            break;
+        }
+    }
+
+    // No gap large enough - grow the file (a trailing free run is extended)
+    if (runLength < sectorCountNeeded) {
+        if (runLength == 0) {
+            runStart = static_cast<int>(usedSectors.size());
+        }
+        usedSectors.resize(static_cast<size_t>(runStart) + sectorCountNeeded, false);
+    }
+
+    for (int s = 0; s < sectorCountNeeded; s++) {
+        usedSectors[runStart + s] = true;
+    }
+    return runStart;
+}
+
+bool RegionFile::writeLocation(int index) {
+    uint8_t entry[4];
+    writeU32(entry, locations[index]);
+    std::fseek(file, static_cast<long>(index) * 4, SEEK_SET);
+    unflushedWrites = true;
+    return std::fwrite(entry, 1, sizeof(entry), file) == sizeof(entry);
+}
+
+void RegionFile::flush() {
+    if (file) {
+        std::fflush(file);
+        unflushedWrites = false;
+    }
+}
+
+void RegionFile::sync() {
+    if (!file) return;
+
+    std::fflush(file);
+    unflushedWrites = false;
+    syncFlushed();
+}
+
+void RegionFile::syncFlushed() {
+    if (!file) return;
+
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+ChunkCoord RegionFile::chunkToRegion(const ChunkCoord& chunk) {
+    return ChunkCoord(floorDiv(chunk.x, REGION_SIZE), floorDiv(chunk.z, REGION_SIZE));
+}
+
+int RegionFile::chunkToLocalIndex(const ChunkCoord& chunk) {
+    int localX = chunk.x - floorDiv(chunk.x, REGION_SIZE) * REGION_SIZE;
+    int localZ = chunk.z - floorDiv(chunk.z, REGION_SIZE) * REGION_SIZE;
+    return localIndex(localX, localZ);
+}
+
+// ChunkCodec namespace implementation
+namespace ChunkCodec {
+
+    // Each run is (length u16, type u8, metadata u8); chunk storage is y-major so
+    // horizontal layers of stone, air and water collapse into a handful of runs
+    void compress(const BlockData* blocks, size_t count, std::vector<uint8_t>& out) {
+        out.clear();
+
+        size_t i = 0;
+        while (i < count) {
+            BlockData value = blocks[i];
+            size_t run = 1;
+            while (i + run < count && run < 0xFFFF && blocks[i + run] == value) {
+                run++;
+            }
+
+            out.push_back(static_cast<uint8_t>(run));
+            out.push_back(static_cast<uint8_t>(run >> 8));
+            out.push_back(static_cast<uint8_t>(value.type));
+            out.push_back(value.metadata);
+            i += run;
+        }
+    }
+
+    bool decompress(const uint8_t* data, size_t size, BlockData* blocks, size_t count) {
+        if (size % 4 != 0) {
+            return false;
+        }
+
+        size_t written = 0;
+        for (size_t pos = 0; pos < size; pos += 4) {
+            size_t run = static_cast<size_t>(data[pos]) | (static_cast<size_t>(data[pos + 1]) << 8);
+            uint8_t type = data[pos + 2];
+
+            if (run == 0 || written + run > count || type >= static_cast<uint8_t>(BlockType::COUNT)) {
+                return false;
+            }
+
+            std::fill(blocks + written, blocks + written + run,
+                      BlockData(static_cast<BlockType>(type), data[pos + 3]));
+            written += run;
+        }
+
+        return written == count;
+    }
+
+    static void writeVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static bool readVarint(const uint8_t* data, size_t size, size_t& pos, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 32 && pos < size; shift += 7) {
+            uint8_t byte = data[pos++];
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t encodeDelta(const BlockData* blocks, const BlockData* baseline, size_t count, std::vector<uint8_t>& out) {
+        out.clear();
+
+        size_t changed = 0;
+        size_t previous = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (blocks[i] == baseline[i]) {
+                continue;
+            }
+
+            // Gap from the previous entry keeps indices to one byte for clustered edits
+            writeVarint(out, static_cast<uint32_t>(i - previous));
+            out.push_back(static_cast<uint8_t>(blocks[i].type));
+            out.push_back(blocks[i].metadata);
+            previous = i;
+            changed++;
+        }
+
+        return changed;
+    }
+
+    bool applyDelta(const uint8_t* data, size_t size, BlockData* blocks, size_t count) {
+        size_t pos = 0;
+        size_t index = 0;
+        while (pos < size) {
+            uint32_t gap;
+            if (!readVarint(data, size, pos, gap) || pos + 2 > size) {
+                return false;
+            }
+
+            index += gap;
+            uint8_t type = data[pos];
+            if (index >= count || type >= static_cast<uint8_t>(BlockType::COUNT)) {
+                return false;
+            }
+
+            blocks[index] = BlockData(static_cast<BlockType>(type), data[pos + 1]);
+            pos += 2;
+        }
+
+        return true;
+    }
+}
+
+// ChunkStorage implementation
+ChunkStorage::ChunkStorage(const std::string& directory, uint32_t seed) : directory(directory) {
+    openSaveInfo(seed);
+}
+
+ChunkStorage::~ChunkStorage() {
+    flush();
+}
+
+void ChunkStorage::openSaveInfo(uint32_t seed) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    std::string infoPath = directory + "/save.info";
+
+    // One "key value" pair per line; unknown keys are ignored
+    bool hasData = fs::exists(directory, error) && !fs::is_empty(directory, error);
+    if (hasData) {
+        std::ifstream info(infoPath);
+        std::string key;
+        uint64_t value;
+        uint64_t format = 0, generator = 0, savedSeed = 0;
+        bool hasSeed = false;
+        while (info >> key >> value) {
+            if (key == "format") format = value;
+            else if (key == "generator") generator = value;
+            else if (key == "seed") { savedSeed = value; hasSeed = true; }
+        }
+
+        if (format == REGION_FORMAT_VERSION && generator == Chunk::GENERATOR_VERSION && hasSeed && savedSeed == seed) {
+            return;
+        }
+
+        // Keep the old files for recovery, but never decode them against this generator
+        incompatiblePath = directory + ".incompatible";
+        for (int suffix = 1; fs::exists(incompatiblePath, error); suffix++) {
+            incompatiblePath = directory + ".incompatible" + std::to_string(suffix);
+        }
+        fs::rename(directory, incompatiblePath, error);
+        if (error) {
+            std::cerr << "Failed to move incompatible save " << directory << ": " << error.message() << std::endl;
+            incompatiblePath.clear();
+            fs::remove_all(directory, error);
+        } else {
+            std::cerr << "Save " << directory << " was written by a different generator or format (format "
+                      << format << ", generator " << generator << "), moved to " << incompatiblePath << std::endl;
+        }
+    }
+
+    fs::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Failed to create save directory " << directory << ": " << error.message() << std::endl;
+        return;
+    }
+
+    // Written before any region file exists, so a save without it is never trusted
+    std::ofstream info(infoPath, std::ios::trunc);
+    info << "format " << REGION_FORMAT_VERSION << "\n"
+         << "generator " << Chunk::GENERATOR_VERSION << "\n"
+         << "seed " << seed << "\n";
+    if (!info) {
+        std::cerr << "Failed to write " << infoPath << std::endl;
+    }
+}
+
+RegionFile* ChunkStorage::getRegion(const ChunkCoord& regionCoord, bool create) {
+    auto it = regions.find(regionCoord);
+    if (it != regions.end()) {
+        return it->second.get();
+    }
+
+    std::string path = directory + "/r." + std::to_string(regionCoord.x) + "." +
+                       std::to_string(regionCoord.z) + ".mcr";
+    if (!create && !std::filesystem::exists(path)) {
+        return nullptr;
+    }
+
+    auto region = std::make_unique<RegionFile>(path);
+    if (!region->isOpen()) {
+        return nullptr;
+    }
+
+    RegionFile* result = region.get();
+    regions[regionCoord] = std::move(region);
+    return result;
+}
+
+bool ChunkStorage::loadChunk(Chunk& chunk) {
+    return loadChunk(chunk.getCoord(), chunk.getBlockData());
+}
+
+bool ChunkStorage::loadChunk(ChunkCoord coord, BlockData* blocks) {
+    // Per-thread so decoding and delta baselines never need the storage lock
+    thread_local std::vector<uint8_t> deltaPayload;
+    std::string regionPath;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        RegionFile* region = getRegion(RegionFile::chunkToRegion(coord), false);
+        if (!region) return false;
+
+        int index = RegionFile::chunkToLocalIndex(coord);
+        int localX = index % REGION_SIZE;
+        int localZ = index / REGION_SIZE;
+        if (!region->hasChunk(localX, localZ)) {
+            return false;
+        }
+
+        // Decode straight from the mapped pages; fall back to a buffered read if mapping failed
+        thread_local std::vector<uint8_t> readBuffer;
+        RegionCompression compression;
+        const uint8_t* payload = nullptr;
+        size_t size = 0;
+        if (!region->mapChunk(localX, localZ, payload, size, compression)) {
+            if (!region->readChunk(localX, localZ, readBuffer, compression)) {
+                return false;
+            }
+            payload = readBuffer.data();
+            size = readBuffer.size();
+        }
+
+        // Snapshots decode in place (the mapping is only valid under the lock); a delta is a
+        // few bytes, so copy it out and run the generator for its baseline after unlocking
+        bool decoded = false;
+        if (compression == RegionCompression::DELTA) {
+            deltaPayload.assign(payload, payload + size);
+            regionPath = region->getPath();
+        } else {
+            if (compression == RegionCompression::RLE) {
+                decoded = ChunkCodec::decompress(payload, size, blocks, BLOCKS_PER_CHUNK);
+            } else if (compression == RegionCompression::NONE && size == sizeof(BlockData) * BLOCKS_PER_CHUNK) {
+                std::memcpy(blocks, payload, size);
+                decoded = true;
+            }
+            if (!decoded) {
+                std::cerr << "Discarding unreadable chunk (" << coord.x << ", " << coord.z << ") in "
+                          << region->getPath() << std::endl;
+            }
+            return decoded;
+        }
+    }
+
+    // Regenerate the baseline and replay the edits on top of it
+    Chunk::generateBlocks(coord, blocks);
+    if (!ChunkCodec::applyDelta(deltaPayload.data(), deltaPayload.size(), blocks, BLOCKS_PER_CHUNK)) {
+        std::cerr << "Discarding unreadable chunk (" << coord.x << ", " << coord.z << ") in "
+                  << regionPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void ChunkStorage::prefetchChunks(const std::vector<ChunkCoord>& coords) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const ChunkCoord& coord : coords) {
+        RegionFile* region = getRegion(RegionFile::chunkToRegion(coord), false);
+        if (!region) continue;
+
+        int index = RegionFile::chunkToLocalIndex(coord);
+        region->prefetchChunk(index % REGION_SIZE, index / REGION_SIZE);
+    }
+}
+
+bool ChunkStorage::saveChunk(const Chunk& chunk) {
+    return saveChunk(chunk.getCoord(), chunk.getBlockData());
+}
+
+bool ChunkStorage::saveChunk(ChunkCoord coord, const BlockData* blocks, size_t* bytesWritten) {
+    if (bytesWritten) {
+        *bytesWritten = 0;
+    }
+
+    int index = RegionFile::chunkToLocalIndex(coord);
+    int localX = index % REGION_SIZE;
+    int localZ = index / REGION_SIZE;
+
+    // Generating and encoding happen outside the lock so loads on the main thread never
+    // wait for them; the buffers are per-thread for the same reason
+    thread_local std::vector<BlockData> baseline;
+    thread_local std::vector<uint8_t> encoded;
+    thread_local std::vector<uint8_t> snapshot;
+
+    // Diff against what the generator would produce for this chunk
+    baseline.resize(BLOCKS_PER_CHUNK);
+    Chunk::generateBlocks(coord, baseline.data());
+    size_t changed = ChunkCodec::encodeDelta(blocks, baseline.data(), BLOCKS_PER_CHUNK, encoded);
+
+    // Matches the generator - drop any stale entry, never create a file for it
+    if (changed == 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        RegionFile* region = getRegion(RegionFile::chunkToRegion(coord), false);
+        return region ? region->removeChunk(localX, localZ) : true;
+    }
+
+    // Heavily rebuilt chunks are cheaper as a full snapshot
+    RegionCompression compression = RegionCompression::DELTA;
+    ChunkCodec::compress(blocks, BLOCKS_PER_CHUNK, snapshot);
+    if (snapshot.size() < encoded.size()) {
+        encoded.swap(snapshot);
+        compression = RegionCompression::RLE;
+    }
+
+    // Noisy chunks can encode larger than raw storage - store those uncompressed
+    const uint8_t* payload = encoded.data();
+    size_t payloadSize = encoded.size();
+    if (payloadSize > sizeof(BlockData) * BLOCKS_PER_CHUNK) {
+        payload = reinterpret_cast<const uint8_t*>(blocks);
+        payloadSize = sizeof(BlockData) * BLOCKS_PER_CHUNK;
+        compression = RegionCompression::NONE;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        RegionFile* region = getRegion(RegionFile::chunkToRegion(coord));
+        if (!region || !region->writeChunk(localX, localZ, payload, payloadSize, compression)) {
+            return false;
+        }
+    }
+
+    if (bytesWritten) {
+        *bytesWritten = payloadSize + REGION_PAYLOAD_HEADER_SIZE;
+    }
+    return true;
+}
+
+void ChunkStorage::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& pair : regions) {
+        pair.second->flush();
+    }
+}
+
+void ChunkStorage::sync() {
+    // Flush under the lock, then fsync without it so loads are not stuck behind the disk.
+    // Regions stay open for the storage's lifetime and only the saving thread writes them.
+    std::vector<RegionFile*> flushed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushed.reserve(regions.size());
+        for (auto& pair : regions) {
+            pair.second->flush();
+            flushed.push_back(pair.second.get());
+        }
+    }
+
+    for (RegionFile* region : flushed) {
+        region->syncFlushed();
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "chunk.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file region_file.h
+ * @brief Region file persistence - 32x32 chunks per file with sector-aligned payloads
+ *
+ * File layout:
+ *   sector 0      : location table, one 4-byte entry per chunk (sector offset << 8 | sector count)
+ *   sector 1..n   : chunk payloads, each starting on a sector boundary
+ *
+ * Each payload starts with a 4-byte length and a 1-byte compression tag followed by the
+ * compressed chunk data. A chunk that still fits in its old sectors is rewritten in place.
+ *
+ * Edited chunks are normally stored as a DELTA against the deterministic generator output,
+ * so a chunk whose blocks match the generator has no entry (and costs zero bytes) at all.
+ *
+ * Every save directory holds a save.info naming the seed, Chunk::GENERATOR_VERSION and
+ * REGION_FORMAT_VERSION it was written with. A directory that does not match (or predates
+ * save.info) is moved aside on open, so chunks fall back to the generator instead of
+ * decoding deltas against the wrong baseline.
+ *
+ * Reads go through a read-only memory mapping of the whole file: payloads are decoded
+ * straight from the mapped pages into chunk storage. Writes still use the stream and the
+ * mapping is refreshed lazily when a read falls past its end (i.e. the file has grown).
+ */
+
+// Region layout constants
+constexpr int REGION_SIZE = 32;                                  // Chunks per region side
+constexpr int REGION_CHUNK_COUNT = REGION_SIZE * REGION_SIZE;
+constexpr int REGION_SECTOR_SIZE = 4096;                         // Alignment of every read and write
+constexpr int REGION_HEADER_SECTORS = 1;
+constexpr int REGION_MAX_CHUNK_SECTORS = 255;                    // Sector count is stored in one byte
+constexpr int REGION_PAYLOAD_HEADER_SIZE = 5;                    // Length (4) + compression tag (1)
+constexpr uint32_t REGION_FORMAT_VERSION = 1;                    // Payload layout and codecs, see save.info
+
+// Compression tags stored in front of each payload
+enum class RegionCompression : uint8_t {
+    NONE = 0,   // Raw BlockData snapshot
+    RLE = 1,    // Run-length encoded snapshot
+    DELTA = 2   // Sparse edits on top of Chunk::generateBlocks()
+};
+
+class RegionFile {
+public:
+    explicit RegionFile(const std::string& path);
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+    const std::string& getPath() const { return path; }
+
+    // Chunk payload access (local coordinates 0..REGION_SIZE-1)
+    bool hasChunk(int localX, int localZ) const;
+    bool readChunk(int localX, int localZ, std::vector<uint8_t>& payload, RegionCompression& compression);
+    // Zero-copy read: points into the mapping, valid until the next write to this region
+    bool mapChunk(int localX, int localZ, const uint8_t*& payload, size_t& size, RegionCompression& compression);
+    // Hint the OS to start paging a chunk's sectors in (madvise; no-op on Windows)
+    void prefetchChunk(int localX, int localZ);
+    bool writeChunk(int localX, int localZ, const uint8_t* data, size_t size, RegionCompression compression);
+    bool removeChunk(int localX, int localZ);
+
+    // Push buffered writes to the operating system
+    void flush();
+    // Flush and force the file contents to stable storage (fsync)
+    void sync();
+    // fsync only - leaves the stream alone, so it may run while another thread reads the file
+    void syncFlushed();
+
+    // Coordinate helpers
+    static ChunkCoord chunkToRegion(const ChunkCoord& chunk);
+    static int chunkToLocalIndex(const ChunkCoord& chunk);
+
+private:
+    std::string path;
+    std::FILE* file;
+    std::array<uint32_t, REGION_CHUNK_COUNT> locations;
+    std::vector<bool> usedSectors;
+    bool unflushedWrites;           // Stream buffer holds data the mapping cannot see yet
+
+    // Read-only mapping of the file
+    const uint8_t* mappedData;
+    size_t mappedSize;
+#ifdef _WIN32
+    void* mappingHandle;
+#endif
+
+    bool loadHeader();
+    bool remap();
+    void unmap();
+    bool writeLocation(int index);
+    int allocateSectors(int index, int sectorCount);
+
+    static int localIndex(int localX, int localZ) { return localZ * REGION_SIZE + localX; }
+    static uint32_t sectorOffset(uint32_t location) { return location >> 8; }
+    static uint32_t sectorCount(uint32_t location) { return location & 0xFF; }
+};
+
+// Chunk <-> payload encoding (run-length encoded BlockData, y-major like chunk storage)
+namespace ChunkCodec {
+    void compress(const BlockData* blocks, size_t count, std::vector<uint8_t>& out);
+    bool decompress(const uint8_t* data, size_t size, BlockData* blocks, size_t count);
+
+    // Sparse (index gap varint, type, metadata) list of blocks that differ from the baseline
+    // Returns the number of differing blocks
+    size_t encodeDelta(const BlockData* blocks, const BlockData* baseline, size_t count, std::vector<uint8_t>& out);
+    bool applyDelta(const uint8_t* data, size_t size, BlockData* blocks, size_t count);
+}
+
+/**
+ * @brief Directory of region files for one world - opens regions lazily and keeps them open
+ *
+ * Thread-safe: the chunk I/O thread saves while the main thread loads. The lock only covers
+ * the region table and file access; generating delta baselines, encoding and fsync run
+ * outside it.
+ */
+class ChunkStorage {
+public:
+    // Opens (or starts) the save for a world seed; an incompatible save is moved aside first
+    ChunkStorage(const std::string& directory, uint32_t seed);
+    ~ChunkStorage();
+
+    const std::string& getDirectory() const { return directory; }
+    // Where an incompatible save was moved on open (empty when the save was usable)
+    const std::string& getIncompatiblePath() const { return incompatiblePath; }
+
+    // Returns false when the chunk has never been saved (caller should generate it)
+    bool loadChunk(Chunk& chunk);
+    bool loadChunk(ChunkCoord coord, BlockData* blocks);
+    bool saveChunk(const Chunk& chunk);
+    bool saveChunk(ChunkCoord coord, const BlockData* blocks, size_t* bytesWritten = nullptr);
+
+    // Ask the OS to page in saved chunks ahead of loadChunk (regions are never created)
+    void prefetchChunks(const std::vector<ChunkCoord>& coords);
+
+    void flush();
+    void sync();
+
+private:
+    std::mutex mutex;
+    std::string directory;
+    std::string incompatiblePath;
+    std::unordered_map<ChunkCoord, std::unique_ptr<RegionFile>, ChunkCoord::Hash> regions;
+
+    RegionFile* getRegion(const ChunkCoord& regionCoord, bool create = true);
+    // Check save.info against this build and seed; moves a mismatching save aside
+    void openSaveInfo(uint32_t seed);
+};
@@ -0,0 +1,74 @@
+#include "worker_pool.h"
+#include <algorithm>
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(size_t count, size_t threadCount, const std::function<void(size_t)>& work) {
+    if (count == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> batchLock(batchMutex);
+    std::unique_lock<std::mutex> lock(mutex);
+    size_t helpers = std::min(std::max<size_t>(threadCount, 1), count) - 1;
+    while (workers.size() < helpers) {
+        workers.emplace_back(&WorkerPool::workerLoop, this, workers.size());
+    }
+
+    task = &work;
+    taskCount = count;
+    nextTask = 0;
+    finishedTasks = 0;
+    activeWorkers = helpers;
+    batch++;
+    if (helpers > 0) {
+        wakeCondition.notify_all();
+    }
+
+    takeTasks(lock);
+    doneCondition.wait(lock, [this] { return finishedTasks == taskCount; });
+    task = nullptr;
+}
+
+size_t WorkerPool::getWorkerCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return workers.size();
+}
+
+void WorkerPool::workerLoop(size_t index) {
+    uint64_t seenBatch = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeCondition.wait(lock, [&] { return stopRequested || batch != seenBatch; });
+        if (stopRequested) {
+            return;
+        }
+        seenBatch = batch;
+
+        // A worker that wakes after its batch is done finds no task left to take
+        if (index < activeWorkers) {
+            takeTasks(lock);
+        }
+    }
+}
+
+void WorkerPool::takeTasks(std::unique_lock<std::mutex>& lock) {
+    while (nextTask < taskCount) {
+        size_t index = nextTask++;
+        lock.unlock();
+        (*task)(index);
+        lock.lock();
+        if (++finishedTasks == taskCount) {
+            doneCondition.notify_all();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file worker_pool.h
+ * @brief Persistent worker threads for short fork-join batches
+ *
+ * Starting and joining a std::thread costs more than a small batch of work is worth. The
+ * pool starts its threads on the first batch that needs them and parks them on a condition
+ * variable between batches; run() hands task indices to the workers and the calling thread
+ * alike and returns once every task has finished.
+ *
+ * One batch runs at a time - concurrent run() calls are serialized.
+ */
+class WorkerPool {
+public:
+    WorkerPool() = default;
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Call task(i) for every i in [0, taskCount) on at most threadCount threads, the caller
+    // included (the pool grows to threadCount - 1 workers if it has fewer). Blocks until done.
+    void run(size_t taskCount, size_t threadCount, const std::function<void(size_t)>& task);
+
+    // Threads started so far (they live until the pool is destroyed)
+    size_t getWorkerCount() const;
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex batchMutex;                  // Held for a whole run()
+
+    mutable std::mutex mutex;               // Guards everything below
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    const std::function<void(size_t)>* task = nullptr;
+    size_t taskCount = 0;
+    size_t nextTask = 0;
+    size_t finishedTasks = 0;
+    size_t activeWorkers = 0;               // Workers [0, activeWorkers) join the current batch
+    uint64_t batch = 0;
+    bool stopRequested = false;
+
+    void workerLoop(size_t index);
+    // Run tasks of the current batch until none are left to take; called with mutex held
+    void takeTasks(std::unique_lock<std::mutex>& lock);
+};
@@ -7,16 +7,26 @@
 #include "world.h"
 #include "chunk.h"
 #include "block.h"
+#include "region_file.h"
+#include "chunk_io.h"
+#include "edit_journal.h"
+#include "block_cursor.h"
 #include "../renderer/simple_shader.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <thread>
 #include <glm/gtc/matrix_transform.hpp>
 
-World::World() : initialized(false), blockShader(nullptr), highlightShader(nullptr),
+World::World() : initialized(false), saveSyncIntervalMs(ChunkIOThread::DEFAULT_SYNC_INTERVAL_MS),
+                  blockShader(nullptr), farTerrainShader(nullptr), highlightShader(nullptr),
                   highlightVAO(0), highlightVBO(0), targetedBlockValid(false),
                   noiseGenerator(1337), renderDistance(DEFAULT_RENDER_DISTANCE) {
     chunkUnloadDistance = renderDistance * CHUNK_UNLOAD_MULTIPLIER + 1.0f;
+    loadRadius = renderDistance;
 
 #ifdef FASTNOISE_AVAILABLE
     // Initialize mountain generation noise
@@ -34,11 +44,27 @@ void World::initialize() {
 
     // Initialize block shader
     blockShader = new SimpleShader("shaders/block.vert", "shaders/block.frag");
+    farTerrainShader = new SimpleShader("shaders/far_terrain.vert", "shaders/block.frag");
 
     // Initialize highlight shader and geometry
     highlightShader = new SimpleShader("shaders/highlight.vert", "shaders/highlight.frag");
     initializeHighlightGeometry();
 
+    // Camera, lighting and fog reach both programs through one uniform buffer
+    frameUniforms.initialize();
+    frameUniforms.attach(*blockShader);
+    frameUniforms.attach(*farTerrainShader);
+    frameUniforms.attach(*highlightShader);
+    for (SimpleShader* shader : {blockShader, farTerrainShader}) {
+        shader->use();
+        shader->setInt("blockTexture", 0);
+    }
+
+    farTerrain.initialize();
+
+    // Edited chunks are saved to and reloaded from region files
+    openChunkStorage();
+
     // Start with no chunks - they will be loaded around the player
     initialized = true;
 }
@@ -46,10 +72,22 @@ void World::initialize() {
 void World::shutdown() {
     if (!initialized) return;
 
-    chunks.clear();    if (blockShader) {
+    // Persist player edits before the chunks go away
+    saveModifiedChunks();
+    closeChunkStorage();
+
+    chunks.clear();
+    cullTree.clear();
+    chunkPool.clear();
+    farTerrain.shutdown();
+    frameUniforms.shutdown();    if (blockShader) {
         delete blockShader;
     blockShader = nullptr;
     }
+    if (farTerrainShader) {
+        delete farTerrainShader;
+        farTerrainShader = nullptr;
+    }
 
     // Cleanup highlight resources
     if (highlightShader) {
@@ -102,7 +140,9 @@ const Chunk* World::getChunk(ChunkCoord coord) const {
 }
 
 void World::addChunk(ChunkCoord coord, std::unique_ptr<Chunk> chunk) {
+    cullTree.insert(chunk.get());
     chunks[coord] = std::move(chunk);
+    blockVersion++;
 }
 
 void World::render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos) {
@@ -112,74 +152,143 @@ void World::render(const glm::mat4& view, const glm::mat4& projection, const glm
     glm::mat4 viewProjection = projection * view;
     viewFrustum.updateFromMatrix(viewProjection);
 
-    // Configure shader
-    blockShader->use();
-    blockShader->setMatrix4("view", view);
-    blockShader->setMatrix4("projection", projection);
-
-    // Set lighting uniforms
-    blockShader->setVector3("lightDirection", glm::vec3(0.2f, -0.8f, 0.1f));
-    blockShader->setVector3("lightColor", glm::vec3(0.8f, 0.8f, 0.7f));
-    blockShader->setVector3("ambientColor", glm::vec3(0.3f, 0.3f, 0.4f));    // Set fog uniforms based on render distance (more aggressive fog to hide generation)
-    float renderDistanceWorldUnits = renderDistance * CHUNK_WIDTH;
-    float fogNear = renderDistanceWorldUnits * 0.60f;  // Start fog earlier
-    float fogFar = renderDistanceWorldUnits * 0.90f;   // End fog before render edge
-    blockShader->setFloat("fogNear", fogNear);
-    blockShader->setFloat("fogFar", fogFar);
+    // Camera, lighting and fog for the whole frame
+    FrameUniforms::Data frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.cameraPosition = cameraPos;
+    frame.lightDirection = glm::vec3(0.2f, -0.8f, 0.1f);
+    frame.lightColor = glm::vec3(0.8f, 0.8f, 0.7f);
+    frame.ambientColor = glm::vec3(0.3f, 0.3f, 0.4f);
+    // Fog based on render distance (more aggressive fog to hide generation)
+    float renderDistanceWorldUnits = loadRadius * CHUNK_WIDTH;
+    frame.fogNear = renderDistanceWorldUnits * 0.60f;  // Start fog earlier
+    frame.fogFar = getHorizonDistance() * 0.90f;       // End fog before the world's edge
     // Match fog color to sky horizon color: #87CEEB (Sky Blue)
-    blockShader->setVector3("fogColor", glm::vec3(0.529f, 0.808f, 0.922f));// Bind texture atlas
-    GLuint textureAtlas = BlockRegistry::getTextureAtlas();
-    if (textureAtlas != 0) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureAtlas);
-        blockShader->setInt("blockTexture", 0);
-    }
-      // Enable blending for water transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    frame.fogColor = glm::vec3(0.529f, 0.808f, 0.922f);
+    frameUniforms.update(frame);
+
+    // Chunks split their meshes into an opaque and a blended draw (Chunk::submitDraw);
+    // far terrain is opaque
+    RenderQueue::DrawState terrainState;
+    terrainState.shader = blockShader;
+    terrainState.texture = BlockRegistry::getTextureAtlas();
 
     // Enable depth testing but allow depth writes for proper sorting
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
     glDepthMask(GL_TRUE); // Allow depth writes for solid blocks
 
-    // Render chunks with frustum culling
-    int chunksRendered = 0;
-    int chunksCulled = 0;
-
-    for (auto& pair : chunks) {
-        if (pair.second && pair.second->isReady()) {
-            // Calculate chunk bounding box for frustum culling
-            glm::vec3 chunkWorldPos = ChunkUtils::chunkToWorldPos(pair.first);
-            glm::vec3 chunkMin = chunkWorldPos;
-            glm::vec3 chunkMax = chunkWorldPos + glm::vec3(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_DEPTH);
-
-            // Frustum culling test
-            if (viewFrustum.containsAABB(chunkMin, chunkMax)) {
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), chunkWorldPos);
-                blockShader->setMatrix4("model", model);
-                pair.second->render(view, projection, cameraPos);
-                chunksRendered++;
-            } else {
-                chunksCulled++;
+    // Hierarchical frustum culling - whole tiles and groups of chunks are accepted or
+    // rejected with one test, using the meshes' real vertical extent
+    ChunkCullTree::Stats cullStats;
+    visibleChunks.clear();
+    cullTree.query(viewFrustum, visibleChunks, cullStats);
+
+    // Cave culling - drop chunks the camera cannot see into through open section faces
+    lastCaveCulledChunks = 0;
+    if (caveCulling) {
+        caveCuller.update(cameraPos, viewFrustum, loadRadius, meshMinSection, meshMaxSection,
+                          [this](ChunkCoord coord) -> const uint16_t* {
+                              const Chunk* chunk = getChunk(coord);
+                              return chunk ? chunk->getSectionConnectivityData() : nullptr;
+                          });
+        size_t kept = 0;
+        for (Chunk* chunk : visibleChunks) {
+            if (caveCuller.isChunkVisible(chunk->getCoord())) {
+                visibleChunks[kept++] = chunk;
             }
         }
+        lastCaveCulledChunks = static_cast<int>(visibleChunks.size() - kept);
+        visibleChunks.resize(kept);
+    }
+
+    lastOccludedChunks = 0;
+    lastOccluders = 0;
+    if (occlusionCulling) {
+        cullOccludedChunks(viewProjection, cameraPos);
+    }
+
+    renderQueue.begin();
+    lastRenderedVertices = 0;
+    lastLodChunks.fill(0);
+    for (Chunk* chunk : visibleChunks) {
+        chunk->submitDraw(renderQueue, terrainState, cameraPos);
+        lastRenderedVertices += chunk->getVertexCount();
+        lastLodChunks[chunk->getLodLevel()]++;
     }
 
+    // Far terrain fills the view beyond the loaded chunks
+    if (farTerrainEnabled) {
+        RenderQueue::DrawState farTerrainState = terrainState;
+        farTerrainState.shader = farTerrainShader;
+        farTerrain.submitDraws(renderQueue, farTerrainState);
+    }
+    renderQueue.flush();
+
     // Store statistics for debugging
-    lastRenderedChunks = chunksRendered;
-    lastCulledChunks = chunksCulled;
+    lastRenderedChunks = static_cast<int>(visibleChunks.size());
+    lastCulledChunks = cullStats.culled;
+    lastTightBoundsCulledChunks = cullStats.tightBoundsCulled;
+    lastFrustumTests = cullStats.frustumTests;
 
     // Disable blending after rendering
     glDisable(GL_BLEND);
 }
 
+void World::cullOccludedChunks(const glm::mat4& viewProjection, const glm::vec3& cameraPos) {
+    occlusionBuffer.begin(viewProjection);
+
+    // Occluders are the solid-from-bedrock cells of frustum-visible chunks near the camera,
+    // clipped to the meshed window so they never hide terrain through an unmeshed gap
+    ChunkCoord cameraChunk = ChunkUtils::worldToChunkCoord(static_cast<int>(std::floor(cameraPos.x)),
+                                                           static_cast<int>(std::floor(cameraPos.z)));
+    int windowBottom = meshMinSection << CurrentChunkGeometry::SECTION_SHIFT;
+    int windowTop = (meshMaxSection + 1) << CurrentChunkGeometry::SECTION_SHIFT;
+    for (const Chunk* chunk : visibleChunks) {
+        ChunkCoord coord = chunk->getCoord();
+        if (std::abs(coord.x - cameraChunk.x) > OCCLUDER_RADIUS || std::abs(coord.z - cameraChunk.z) > OCCLUDER_RADIUS ||
+            chunk->getLodLevel() > 0) {
+            continue;  // Voted LOD meshes can sit below the blocks an occluder stands for
+        }
+
+        glm::vec3 chunkPos = chunk->getWorldPosition();
+        for (int cellZ = 0; cellZ < Chunk::OCCLUDER_CELLS_Z; cellZ++) {
+            for (int cellX = 0; cellX < Chunk::OCCLUDER_CELLS_X; cellX++) {
+                int top = std::min(chunk->getOccluderHeight(cellX, cellZ), windowTop);
+                if (top <= windowBottom) continue;
+
+                glm::vec3 cellMin = chunkPos + glm::vec3(cellX * Chunk::OCCLUDER_CELL, windowBottom, cellZ * Chunk::OCCLUDER_CELL);
+                occlusionBuffer.addOccluder(cellMin, glm::vec3(cellMin.x + Chunk::OCCLUDER_CELL, top,
+                                                               cellMin.z + Chunk::OCCLUDER_CELL));
+            }
+        }
+    }
+    lastOccluders = occlusionBuffer.getOccluderCount();
+    if (lastOccluders == 0) {
+        return;
+    }
+
+    // Compact the visible list in place, keeping chunks any part of which may show
+    size_t kept = 0;
+    for (Chunk* chunk : visibleChunks) {
+        glm::vec3 chunkPos = chunk->getWorldPosition();
+        glm::vec3 boxMin = chunkPos + glm::vec3(0.0f, static_cast<float>(chunk->getMeshMinY()), 0.0f);
+        glm::vec3 boxMax = chunkPos + glm::vec3(CHUNK_WIDTH, static_cast<float>(chunk->getMeshMaxY()), CHUNK_DEPTH);
+        if (occlusionBuffer.isVisible(boxMin, boxMax)) {
+            visibleChunks[kept++] = chunk;
+        }
+    }
+    lastOccludedChunks = static_cast<int>(visibleChunks.size() - kept);
+    visibleChunks.resize(kept);
+}
+
 BlockData World::getBlock(int x, int y, int z) const {
     ChunkCoord chunkCoord = ChunkUtils::worldToChunkCoord(x, z);
     const Chunk* chunk = getChunk(chunkCoord);
 
     if (chunk) {
-        return chunk->getBlockWorld(x, y, z);
+        return chunk->getBlock(CurrentChunkGeometry::worldToLocalX(x), y, CurrentChunkGeometry::worldToLocalZ(z));
     }
 
     return BlockData(BlockType::AIR);
@@ -193,38 +302,185 @@ void World::setBlock(int x, int y, int z, BlockData block) {
         // Convert world coordinates to local chunk coordinates
         glm::ivec3 localPos = ChunkUtils::worldToLocal(x, y, z);
 
+        // Rewriting a block with its own type and metadata leaves nothing to journal, remesh or save
+        BlockData previous = chunk->getBlockWorld(x, y, z);
+        if (previous == block) {
+            return;
+        }
+
+        // Journal the edit so it survives a crash before the chunk is saved
+        if (editJournal && y >= 0 && y < CHUNK_HEIGHT) {
+            editJournal->append(JournalRecord::setBlock(x, y, z, previous, block, editTick++));
+        }
+
         chunk->setBlockWorld(x, y, z, block);
         chunk->markForRemesh();
+        chunk->setModified(true);
+        blockVersion++;
 
-        // Check if this block is at a chunk boundary and notify neighboring chunks
-        // A block is at a boundary if it's at the edge of the chunk (0 or 15 for x,z)
-        std::vector<ChunkCoord> neighborsToUpdate;
-
-        if (localPos.x == 0) {
-            // Block is at the left edge, notify left neighbor
-            neighborsToUpdate.emplace_back(chunkCoord.x - 1, chunkCoord.z);
-        }
-        if (localPos.x == CHUNK_WIDTH - 1) {
-            // Block is at the right edge, notify right neighbor
-            neighborsToUpdate.emplace_back(chunkCoord.x + 1, chunkCoord.z);
+        if (editJournal && editJournal->getSize() > JOURNAL_COMPACT_BYTES) {
+            compactEditJournal();
         }
-        if (localPos.z == 0) {
-            // Block is at the front edge, notify front neighbor
-            neighborsToUpdate.emplace_back(chunkCoord.x, chunkCoord.z - 1);
-        }
-        if (localPos.z == CHUNK_DEPTH - 1) {
-            // Block is at the back edge, notify back neighbor
-            neighborsToUpdate.emplace_back(chunkCoord.x, chunkCoord.z + 1);
+
+        // A block on the edge of the chunk changes the faces its neighbor renders
+        markNeighborsForRemesh(chunkCoord, localPos.x == 0, localPos.x == CHUNK_WIDTH - 1,
+                               localPos.z == 0, localPos.z == CHUNK_DEPTH - 1);
+    }
+}
+
+void World::markNeighborsForRemesh(ChunkCoord coord, bool minX, bool maxX, bool minZ, bool maxZ) {
+    const std::array<std::pair<bool, ChunkCoord>, 4> neighbors = {{
+        {minX, ChunkCoord(coord.x - 1, coord.z)},
+        {maxX, ChunkCoord(coord.x + 1, coord.z)},
+        {minZ, ChunkCoord(coord.x, coord.z - 1)},
+        {maxZ, ChunkCoord(coord.x, coord.z + 1)}
+    }};
+
+    for (const auto& neighbor : neighbors) {
+        if (!neighbor.first) continue;
+        Chunk* neighborChunk = getChunk(neighbor.second);
+        if (neighborChunk) {
+            neighborChunk->markForRemesh();
         }
+    }
+}
 
-        // Mark neighboring chunks for remeshing
-        for (const ChunkCoord& neighborCoord : neighborsToUpdate) {
-            Chunk* neighborChunk = getChunk(neighborCoord);
-            if (neighborChunk) {
-                neighborChunk->markForRemesh();
+template <typename RowEdit, typename ChunkEdited>
+size_t World::editRegion(const glm::ivec3& cornerA, const glm::ivec3& cornerB, RowEdit editRow, ChunkEdited onChunkEdited) {
+    using Geometry = CurrentChunkGeometry;
+
+    glm::ivec3 lo = glm::min(cornerA, cornerB);
+    glm::ivec3 hi = glm::max(cornerA, cornerB);
+    lo.y = std::max(lo.y, 0);
+    hi.y = std::min(hi.y, Geometry::HEIGHT - 1);
+    if (lo.y > hi.y) {
+        return 0;
+    }
+
+    size_t total = 0;
+    for (int cx = Geometry::worldToChunkX(lo.x); cx <= Geometry::worldToChunkX(hi.x); cx++) {
+        for (int cz = Geometry::worldToChunkZ(lo.z); cz <= Geometry::worldToChunkZ(hi.z); cz++) {
+            ChunkCoord coord(cx, cz);
+            Chunk* chunk = getChunk(coord);
+            if (!chunk) continue;
+
+            // The box clipped to this chunk, in local coordinates
+            int baseX = Geometry::chunkToWorldX(cx);
+            int baseZ = Geometry::chunkToWorldZ(cz);
+            int x0 = std::max(lo.x, baseX) - baseX;
+            int x1 = std::min(hi.x, baseX + Geometry::WIDTH - 1) - baseX;
+            int z0 = std::max(lo.z, baseZ) - baseZ;
+            int z1 = std::min(hi.z, baseZ + Geometry::DEPTH - 1) - baseZ;
+            int runLength = x1 - x0 + 1;
+
+            BlockData* blocks = chunk->getBlockData();
+            size_t changed = 0;
+            for (int y = lo.y; y <= hi.y; y++) {
+                for (int z = z0; z <= z1; z++) {
+                    changed += editRow(blocks + Geometry::blockIndex(x0, y, z), runLength, baseX + x0, y, baseZ + z);
+                }
             }
+
+            if (changed == 0) continue;
+            total += changed;
+            chunk->recountSections(Geometry::sectionOf(lo.y), Geometry::sectionOf(hi.y));
+
+            onChunkEdited(glm::ivec3(baseX + x0, lo.y, baseZ + z0), glm::ivec3(baseX + x1, hi.y, baseZ + z1));
+            chunk->markForRemesh();
+            chunk->setModified(true);
+            markNeighborsForRemesh(coord, x0 == 0, x1 == Geometry::WIDTH - 1, z0 == 0, z1 == Geometry::DEPTH - 1);
         }
     }
+
+    if (total > 0) {
+        blockVersion++;
+    }
+    if (total > 0 && editJournal && editJournal->getSize() > JOURNAL_COMPACT_BYTES) {
+        compactEditJournal();
+    }
+    return total;
+}
+
+size_t World::fillRegion(const glm::ivec3& cornerA, const glm::ivec3& cornerB, BlockData block) {
+    return editRegion(cornerA, cornerB,
+        [block](BlockData* row, int count, int, int, int) {
+            size_t changed = 0;
+            for (int i = 0; i < count; i++) {
+                changed += row[i] != block;
+                row[i] = block;
+            }
+            return changed;
+        },
+        [&](const glm::ivec3& minCorner, const glm::ivec3& maxCorner) {
+            // One box record per chunk instead of one per block
+            if (editJournal) {
+                editJournal->append(JournalRecord::fill(minCorner, maxCorner, block, editTick++));
+            }
+        });
+}
+
+size_t World::replaceRegion(const glm::ivec3& cornerA, const glm::ivec3& cornerB, BlockData from, BlockData to) {
+    if (from == to) {
+        return 0;
+    }
+
+    return editRegion(cornerA, cornerB,
+        [&](BlockData* row, int count, int worldX, int y, int worldZ) {
+            // A conditional record would not replay correctly over a later snapshot
+            // (see edit_journal.h), so only the blocks that actually change are journaled
+            size_t changed = 0;
+            for (int i = 0; i < count; i++) {
+                if (row[i] != from) continue;
+                if (editJournal) {
+                    editJournal->append(JournalRecord::setBlock(worldX + i, y, worldZ, from, to, editTick++));
+                }
+                row[i] = to;
+                changed++;
+            }
+            return changed;
+        },
+        [](const glm::ivec3&, const glm::ivec3&) {});
+}
+
+size_t World::pasteRegion(const glm::ivec3& origin, const glm::ivec3& size, const std::vector<BlockData>& blocks) {
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0 ||
+        blocks.size() != static_cast<size_t>(size.x) * size.y * size.z) {
+        std::cerr << "pasteRegion: block data does not match the region size" << std::endl;
+        return 0;
+    }
+
+    return editRegion(origin, origin + size - 1,
+        [&](BlockData* row, int count, int worldX, int y, int worldZ) {
+            const BlockData* source = blocks.data() +
+                (static_cast<size_t>(y - origin.y) * size.z + (worldZ - origin.z)) * size.x + (worldX - origin.x);
+
+            // Pasted data is arbitrary, so only the blocks that actually change are journaled
+            size_t changed = 0;
+            for (int i = 0; i < count; i++) {
+                if (row[i] == source[i]) continue;
+                if (editJournal) {
+                    editJournal->append(JournalRecord::setBlock(worldX + i, y, worldZ, row[i], source[i], editTick++));
+                }
+                row[i] = source[i];
+                changed++;
+            }
+            return changed;
+        },
+        [](const glm::ivec3&, const glm::ivec3&) {});
+}
+
+int World::getSurfaceHeight(int x, int z) const {
+    return Chunk::getColumnHeight(x, z);
+}
+
+void World::getSurfaceHeights(int x0, int z0, int width, int depth, std::vector<int>& outHeights) const {
+    if (width <= 0 || depth <= 0) {
+        outHeights.clear();
+        return;
+    }
+
+    outHeights.resize(static_cast<size_t>(width) * depth);
+    Chunk::getColumnHeights(x0, z0, width, depth, outHeights.data());
 }
 
 void World::generateSimpleTerrain(Chunk* chunk) {
@@ -256,6 +512,25 @@ void World::generateSimpleTerrain(Chunk* chunk) {
 }
 
 void World::updateChunksAroundPlayer(const glm::vec3& playerPos) {
+    prefetchAhead(playerPos);
+
+    int section = CurrentChunkGeometry::sectionOf(static_cast<int>(std::floor(playerPos.y)));
+    if (section != playerSection) {
+        playerSection = section;
+        updateVerticalWindow();
+    }
+
+    if (farTerrainEnabled) {
+        // Leave a chunk of overlap so the loaded area's ragged edge never shows sky
+        farTerrain.update(playerPos, static_cast<float>(std::max(0, loadRadius - 1) * CHUNK_WIDTH));
+    }
+
+    ChunkCoord playerChunk = ChunkUtils::worldToChunkCoord(playerPos);
+    if (playerChunk != lodCenter) {
+        lodCenter = playerChunk;
+        updateLodLevels();
+    }
+
     // Get list of chunks that should be loaded around player
     std::vector<ChunkCoord> chunksToLoad = getChunksAroundPosition(playerPos);
 
@@ -280,14 +555,133 @@ void World::updateChunksAroundPlayer(const glm::vec3& playerPos) {
     for (const ChunkCoord& coord : chunksToUnload) {
         unloadChunk(coord);
         chunksUnloaded++;    }
+
+    enforceMemoryBudget(playerPos);
+}
+
+void World::enforceMemoryBudget(const glm::vec3& playerPos) {
+    auto now = std::chrono::steady_clock::now();
+
+    memoryManager.setCacheBytes(chunkCache.getBytes());
+    memoryManager.setPoolBytes(chunkPool.getPooledBytes());
+    memoryManager.setMeshBytes(Chunk::getMeshScratchBytes());
+
+    // The chunk cache and the chunk pool are the cheapest memory to give back
+    if (memoryManager.isOverBudget()) {
+        size_t lowWater = memoryManager.getLowWaterBytes();
+        size_t chunkBytes = memoryManager.getChunkBytes() + memoryManager.getFixedBytes();
+        chunkCache.trim(lowWater > chunkBytes ? lowWater - chunkBytes : 0);
+        memoryManager.setCacheBytes(chunkCache.getBytes());
+    }
+    if (memoryManager.isOverBudget()) {
+        chunkPool.clear();
+        memoryManager.setPoolBytes(0);
+    }
+
+    if (memoryManager.isOverBudget()) {
+        // Chunks inside the smallest load radius would be reloaded next frame, so they stay
+        float keepDistance = MIN_LOAD_RADIUS * CHUNK_WIDTH + CHUNK_WIDTH / 2.0f;
+        std::vector<ChunkCoord> victims = memoryManager.selectEvictions(playerPos, keepDistance);
+        float nearestEvicted = std::numeric_limits<float>::max();
+        for (const ChunkCoord& coord : victims) {
+            nearestEvicted = std::min(nearestEvicted, ChunkUtils::chunkDistanceToPoint(coord, playerPos));
+            unloadChunk(coord);
+        }
+
+        // Evicted chunks landed in the cache and the pool; keep only what still fits
+        chunkPool.clear();
+        memoryManager.setPoolBytes(0);
+        size_t lowWater = memoryManager.getLowWaterBytes();
+        size_t chunkBytes = memoryManager.getChunkBytes() + memoryManager.getFixedBytes();
+        chunkCache.trim(lowWater > chunkBytes ? lowWater - chunkBytes : 0);
+        memoryManager.setCacheBytes(chunkCache.getBytes());
+
+        // Shrink the load radius inside the evicted ring so it is not reloaded next frame
+        if (!victims.empty()) {
+            int radius = static_cast<int>(std::ceil((nearestEvicted - CHUNK_WIDTH / 2.0f) / CHUNK_WIDTH)) - 1;
+            loadRadius = std::max(MIN_LOAD_RADIUS, std::min(loadRadius, radius));
+            lastRadiusChange = now;
+        }
+
+        if (memoryManager.isOverBudget() && !memoryBudgetUnmet) {
+            std::cerr << "Memory budget of " << memoryManager.getBudget() / (1024 * 1024) << " MB cannot be met: "
+                      << memoryManager.getTotalBytes() / (1024 * 1024) << " MB in use with only the chunks around "
+                      << "the player loaded" << std::endl;
+        }
+        memoryBudgetUnmet = memoryManager.isOverBudget();
+    } else {
+        memoryBudgetUnmet = false;
+        if (loadRadius < renderDistance &&
+            memoryManager.getTotalBytes() < memoryManager.getLowWaterBytes() &&
+            std::chrono::duration<float>(now - lastRadiusChange).count() > LOAD_RADIUS_REGROW_SECONDS) {
+            // Grow back one ring at a time once there is headroom again
+            loadRadius++;
+            lastRadiusChange = now;
+        }
+    }
+}
+
+void World::prefetchAhead(const glm::vec3& playerPos) {
+    ChunkCoord playerChunk = ChunkUtils::worldToChunkCoord(playerPos);
+    if (hasLastPlayerChunk && playerChunk == lastPlayerChunk) {
+        return;
+    }
+
+    ChunkCoord previous = lastPlayerChunk;
+    bool hadPrevious = hasLastPlayerChunk;
+    lastPlayerChunk = playerChunk;
+    hasLastPlayerChunk = true;
+    if (!chunkStorage || !hadPrevious) {
+        return;
+    }
+
+    // Shift the load circle ahead along the direction of travel; the part not loaded yet is
+    // the crescent the player is about to walk into
+    int stepX = (playerChunk.x > previous.x) - (playerChunk.x < previous.x);
+    int stepZ = (playerChunk.z > previous.z) - (playerChunk.z < previous.z);
+    glm::vec3 ahead = playerPos + glm::vec3(stepX, 0.0f, stepZ) * static_cast<float>(PREFETCH_CHUNKS * CHUNK_WIDTH);
+
+    std::vector<ChunkCoord> upcoming;
+    for (const ChunkCoord& coord : getChunksAroundPosition(ahead)) {
+        if (!isChunkLoaded(coord)) {
+            upcoming.push_back(coord);
+        }
+    }
+    chunkStorage->prefetchChunks(upcoming);
 }
 
 void World::loadChunk(ChunkCoord coord) {    if (isChunkLoaded(coord)) {
         return;  // Chunk already loaded
-    }    auto chunk = std::make_unique<Chunk>(coord, this);
+    }    auto chunk = chunkPool.acquire(coord, this);
+
+    // Prefer a recently unloaded copy, then the saved copy so player edits survive unloading;
+    // otherwise generate from noise. A snapshot still queued on the I/O thread is newer than
+    // anything on disk
+    auto loadStart = std::chrono::steady_clock::now();
+    bool revisit = !visitedChunks.insert(coord).second;
+    if (chunkCache.take(coord, chunk->getBlockData())) {
+        chunk->setState(ChunkState::GENERATED);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        cachedLoads.record(ms);
+    } else if (chunkIO && chunkIO->copyPending(coord, chunk->getBlockData())) {
+        chunk->setState(ChunkState::GENERATED);
+    } else if (chunkStorage && chunkStorage->loadChunk(*chunk)) {
+        chunk->setState(ChunkState::GENERATED);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        (revisit ? revisitDiskLoads : coldDiskLoads).record(ms);
+    } else {
+        chunk->generate();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        generatedLoads.record(ms);
+    }
 
-    // Generate terrain using the improved chunk-based generation
-    chunk->generate();    // Add chunk to the world first
+    // Every path above wrote the block array directly
+    chunk->recountSections();
+    chunk->setMeshSectionRange(meshMinSection, meshMaxSection);
+    chunk->setLodLevel(lodLevelFor(coord));
+
+    // Add chunk to the world first
+    memoryManager.trackChunk(*chunk);
     addChunk(coord, std::move(chunk));
 
     // Notify neighbors that a new chunk is available
@@ -302,7 +696,7 @@ void World::loadChunk(ChunkCoord coord) {    if (isChunkLoaded(coord)) {
         // IMPORTANT: Also mark neighboring chunks for remeshing
         // When a new chunk is loaded, its neighbors need to update their faces
         // because they might have been rendering boundary faces that should now be culled
-        std::vector<ChunkCoord> neighborCoords = {
+        const std::array<ChunkCoord, 4> neighborCoords = {
             ChunkCoord(coord.x - 1, coord.z),     // Left
             ChunkCoord(coord.x + 1, coord.z),     // Right
             ChunkCoord(coord.x, coord.z - 1),     // Front
@@ -321,7 +715,143 @@ void World::loadChunk(ChunkCoord coord) {    if (isChunkLoaded(coord)) {
 void World::unloadChunk(ChunkCoord coord) {
     auto it = chunks.find(coord);
     if (it != chunks.end()) {
+        // Only edited chunks are written - untouched ones regenerate identically from noise
+        if (chunkIO && it->second && it->second->isModified()) {
+            chunkIO->queueSave(*it->second);
+        }
+        if (it->second) {
+            chunkCache.store(coord, it->second->getBlockData());
+        }
+        memoryManager.untrackChunk(coord);
+        cullTree.remove(coord);
+        chunkPool.release(std::move(it->second));
         chunks.erase(it);
+        blockVersion++;
+    }
+}
+
+void World::saveModifiedChunks() {
+    if (!chunkIO) return;
+
+    for (auto& pair : chunks) {
+        Chunk* chunk = pair.second.get();
+        if (chunk && chunk->isModified()) {
+            chunkIO->queueSave(*chunk);
+            chunk->setModified(false);
+        }
+    }
+}
+
+void World::flushChunkSaves() {
+    if (chunkIO) {
+        chunkIO->flush();
+    }
+}
+
+void World::openChunkStorage() {
+    // Saves are keyed by seed so a regenerated world never picks up another world's edits
+    std::string directory = std::string(SAVE_ROOT) + "/seed_" + std::to_string(gTerrainSettings.baseSeed);
+    chunkStorage = std::make_unique<ChunkStorage>(directory, gTerrainSettings.baseSeed);
+
+    // Edits journaled before a crash are folded into the region files before anything loads
+    std::string journalPath = directory + "/edits.journal";
+    replayEditJournal(journalPath);
+    editJournal = std::make_unique<EditJournal>(journalPath);
+
+    chunkIO = std::make_unique<ChunkIOThread>(chunkStorage.get(), saveSyncIntervalMs, editJournal.get());
+}
+
+void World::closeChunkStorage() {
+    // Drain the I/O thread before the storage it writes to goes away
+    saveModifiedChunks();
+    flushChunkSaves();
+    chunkIO.reset();
+
+    // Every edit is in the region files now
+    if (editJournal) {
+        editJournal->discard();
+        editJournal.reset();
+    }
+    chunkStorage.reset();
+}
+
+void World::replayEditJournal(const std::string& path) {
+    std::unordered_map<ChunkCoord, std::unique_ptr<BlockData[]>, ChunkCoord::Hash> touched;
+
+    // Records write absolute values and are applied in order, so replaying a prefix that a
+    // newer snapshot already contains ends in the same state (see edit_journal.h)
+    size_t replayed = EditJournal::replay(path, [&](const JournalRecord& record) {
+        editTick = std::max(editTick, record.tick + 1);
+
+        // SET_BLOCK records are one block; FILL boxes were clipped to one chunk when written
+        for (int cx = CurrentChunkGeometry::worldToChunkX(record.x); cx <= CurrentChunkGeometry::worldToChunkX(record.maxX); cx++) {
+            for (int cz = CurrentChunkGeometry::worldToChunkZ(record.z); cz <= CurrentChunkGeometry::worldToChunkZ(record.maxZ); cz++) {
+                ChunkCoord coord(cx, cz);
+                std::unique_ptr<BlockData[]>& blocks = touched[coord];
+                if (!blocks) {
+                    blocks.reset(new BlockData[BLOCKS_PER_CHUNK]);
+                    if (!chunkStorage->loadChunk(coord, blocks.get())) {
+                        Chunk::generateBlocks(coord, blocks.get());
+                    }
+                }
+                record.applyTo(coord, blocks.get());
+            }
+        }
+    });
+
+    if (replayed > 0) {
+        for (const auto& pair : touched) {
+            chunkStorage->saveChunk(pair.first, pair.second.get());
+        }
+        chunkStorage->sync();
+        std::cout << "Recovered " << replayed << " journaled edits in " << touched.size() << " chunks" << std::endl;
+    }
+
+    EditJournal::removeFiles(path);
+}
+
+void World::compactEditJournal() {
+    if (!chunkIO || !editJournal->rotate()) {
+        return;  // A compaction is still in flight
+    }
+
+    // Snapshots of every edited chunk cover everything in the retired journal file
+    saveModifiedChunks();
+    chunkIO->requestJournalCompaction();
+}
+
+uint64_t World::getJournalSize() const {
+    return editJournal ? editJournal->getSize() : 0;
+}
+
+size_t World::getJournalPendingCount() const {
+    return editJournal ? editJournal->getPendingCount() : 0;
+}
+
+int World::getSaveQueueDepth() const {
+    return chunkIO ? chunkIO->getQueueDepth() : 0;
+}
+
+uint64_t World::getSaveBytesWritten() const {
+    return chunkIO ? chunkIO->getBytesWritten() : 0;
+}
+
+uint64_t World::getSaveChunksWritten() const {
+    return chunkIO ? chunkIO->getChunksWritten() : 0;
+}
+
+uint64_t World::getSavesCoalesced() const {
+    return chunkIO ? chunkIO->getSavesCoalesced() : 0;
+}
+
+int World::getSaveSyncInterval() const {
+    return saveSyncIntervalMs;
+}
+
+void World::setSaveSyncInterval(int milliseconds) {
+    saveSyncIntervalMs = std::max(0, milliseconds);
+    if (chunkIO) {
+        chunkIO->setSyncInterval(saveSyncIntervalMs);
     }
 }
 
@@ -350,14 +880,14 @@ std::vector<ChunkCoord> World::getChunksAroundPosition(const glm::vec3& position
     std::vector<ChunkCoord> result;    ChunkCoord centerChunk = ChunkUtils::worldToChunkCoord(position);
 
     // Generate chunks in a square grid around player, but check distance to avoid loading corner chunks that are too far
-    for (int x = centerChunk.x - renderDistance; x <= centerChunk.x + renderDistance; ++x) {
-        for (int z = centerChunk.z - renderDistance; z <= centerChunk.z + renderDistance; ++z) {
+    for (int x = centerChunk.x - loadRadius; x <= centerChunk.x + loadRadius; ++x) {
+        for (int z = centerChunk.z - loadRadius; z <= centerChunk.z + loadRadius; ++z) {
             ChunkCoord coord(x, z);
             // Use actual player position for more accurate distance calculation
             float chunkDistance = ChunkUtils::chunkDistanceToPoint(coord, position);
 
             // Only load chunks within the render distance (convert to world units)
-            if (chunkDistance <= renderDistance * CHUNK_WIDTH + (CHUNK_WIDTH / 2.0f)) {
+            if (chunkDistance <= loadRadius * CHUNK_WIDTH + (CHUNK_WIDTH / 2.0f)) {
                 result.emplace_back(x, z);
             }
         }
@@ -381,6 +911,8 @@ void World::updateDirtyChunks() {
             if (meshesGenerated < maxMeshesThisFrame && chunk->needsRemeshing()) {
                 if (chunk->getState() == ChunkState::GENERATED || chunk->getState() == ChunkState::READY) {
                     chunk->generateMesh();
+                    memoryManager.trackChunk(*chunk);
+                    cullTree.update(chunk);
                     meshesGenerated++;
                 }
             }
@@ -493,12 +1025,165 @@ void World::generatePerlinTerrain(Chunk* chunk) {
 // Terrain generation is now handled by Chunk::generate() method
 // This provides better performance with static noise generators and cleaner code organization
 
+void World::setVerticalStreaming(bool enabled) {
+    verticalStreaming = enabled;
+    updateVerticalWindow();
+}
+
+void World::setVerticalRadius(int sections) {
+    verticalRadius = std::max(1, std::min(CurrentChunkGeometry::SECTION_COUNT, sections));
+    updateVerticalWindow();
+}
+
+void World::updateVerticalWindow() {
+    int minSection = 0;
+    int maxSection = CurrentChunkGeometry::SECTION_COUNT - 1;
+    if (verticalStreaming) {
+        minSection = std::max(minSection, playerSection - verticalRadius);
+        maxSection = std::min(maxSection, playerSection + verticalRadius);
+    }
+
+    if (minSection == meshMinSection && maxSection == meshMaxSection) {
+        return;
+    }
+    meshMinSection = minSection;
+    meshMaxSection = maxSection;
+
+    // Chunks whose non-empty sections are unaffected keep their meshes
+    for (auto& pair : chunks) {
+        pair.second->setMeshSectionRange(meshMinSection, meshMaxSection);
+    }
+}
+
+float World::getHorizonDistance() const {
+    float chunkDistance = static_cast<float>(loadRadius * CHUNK_WIDTH);
+    return farTerrainEnabled ? std::max(chunkDistance, farTerrain.getRadius()) : chunkDistance;
+}
+
+int World::lodLevelFor(ChunkCoord coord) const {
+    if (!lodEnabled) {
+        return 0;
+    }
+    int distance = std::max(std::abs(coord.x - lodCenter.x), std::abs(coord.z - lodCenter.z));
+    for (int level = Chunk::MAX_LOD_LEVEL; level > 0; level--) {
+        if (lodDistances[level - 1] > 0 && distance >= lodDistances[level - 1]) {
+            return level;
+        }
+    }
+    return 0;
+}
+
+void World::updateLodLevels() {
+    for (auto& pair : chunks) {
+        // Border faces and skirts depend on the neighbours' levels, so they remesh too
+        if (pair.second->setLodLevel(lodLevelFor(pair.first))) {
+            markNeighborsForRemesh(pair.first, true, true, true, true);
+        }
+    }
+}
+
+void World::setLodEnabled(bool enabled) {
+    lodEnabled = enabled;
+    updateLodLevels();
+}
+
+void World::setLodDistances(int level1, int level2) {
+    lodDistances[0] = std::max(0, level1);
+    lodDistances[1] = std::max(0, level2);
+    updateLodLevels();
+}
+
 void World::setRenderDistance(int distance) {
-    renderDistance = std::max(2, std::min(32, distance));
+    renderDistance = std::max(2, std::min(MAX_RENDER_DISTANCE, distance));
     chunkUnloadDistance = renderDistance * CHUNK_UNLOAD_MULTIPLIER + 1.0f;
+    loadRadius = renderDistance;  // The memory budget shrinks it again if needed
+}
+
+void World::raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastResult>& results, unsigned int maxThreads) const {
+    results.resize(rays.size());
+    if (rays.empty()) {
+        return;
+    }
+
+    auto traceRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            results[i] = raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance);
+        }
+    };
+
+    // Tracing only reads chunk storage, so contiguous slices need no synchronization
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t threadCount = std::min<size_t>(maxThreads == 0 ? hardwareThreads : maxThreads,
+                                          std::max<size_t>(1, rays.size() / MIN_RAYS_PER_THREAD));
+    if (threadCount == 1) {
+        traceRange(0, rays.size());
+        return;
+    }
+
+    size_t sliceSize = (rays.size() + threadCount - 1) / threadCount;
+    size_t sliceCount = (rays.size() + sliceSize - 1) / sliceSize;
+    raycastWorkers.run(sliceCount, threadCount, [&](size_t slice) {
+        traceRange(slice * sliceSize, std::min((slice + 1) * sliceSize, rays.size()));
+    });
+}
+
+World::RaycastResult World::raycastCached(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+    raycastQueries++;
+    if (raycastCache.valid && raycastCache.blockVersion == blockVersion && raycastCache.origin == origin &&
+        raycastCache.direction == direction && raycastCache.maxDistance == maxDistance) {
+        raycastCacheHits++;
+        return raycastCache.result;
+    }
+
+    raycastCache.result = raycast(origin, direction, maxDistance);
+    raycastCache.origin = origin;
+    raycastCache.direction = direction;
+    raycastCache.maxDistance = maxDistance;
+    raycastCache.blockVersion = blockVersion;
+    raycastCache.valid = true;
+    return raycastCache.result;
 }
 
 // Player Interaction - Raycasting Implementation
+bool World::findEmptyCell(const Chunk* chunk, const glm::ivec3& voxelPos, glm::ivec3& cellMin, glm::ivec3& cellMax) {
+    using Geometry = CurrentChunkGeometry;
+    constexpr int BELOW = std::numeric_limits<int>::min();
+    constexpr int ABOVE = std::numeric_limits<int>::max();
+
+    int baseX = Geometry::chunkToWorldX(Geometry::worldToChunkX(voxelPos.x));
+    int baseZ = Geometry::chunkToWorldZ(Geometry::worldToChunkZ(voxelPos.z));
+    cellMin = glm::ivec3(baseX, BELOW, baseZ);
+    cellMax = glm::ivec3(baseX + Geometry::WIDTH - 1, ABOVE, baseZ + Geometry::DEPTH - 1);
+
+    // An unloaded column is air all the way up and down
+    if (!chunk) {
+        return true;
+    }
+    if (voxelPos.y < 0) {
+        cellMax.y = -1;
+        return true;
+    }
+    if (voxelPos.y >= Geometry::HEIGHT) {
+        cellMin.y = Geometry::HEIGHT;
+        return true;
+    }
+
+    int section = Geometry::sectionOf(voxelPos.y);
+    if (!chunk->isSectionEmpty(section)) {
+        return false;
+    }
+
+    // Grow the cell over the whole run of empty sections; a run touching the bottom or top of
+    // the column continues into the air outside it
+    int first = section;
+    int last = section;
+    while (first > 0 && chunk->isSectionEmpty(first - 1)) first--;
+    while (last < Geometry::SECTION_COUNT - 1 && chunk->isSectionEmpty(last + 1)) last++;
+    cellMin.y = first == 0 ? BELOW : first << Geometry::SECTION_SHIFT;
+    cellMax.y = last == Geometry::SECTION_COUNT - 1 ? ABOVE : ((last + 1) << Geometry::SECTION_SHIFT) - 1;
+    return true;
+}
+
 World::RaycastResult World::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
     RaycastResult result;
     result.hit = false;
@@ -508,9 +1193,6 @@ World::RaycastResult World::raycast(const glm::vec3& origin, const glm::vec3& di
     glm::vec3 rayDir = glm::normalize(direction);
 
     // DDA (Digital Differential Analyzer) algorithm for voxel traversal
-    // Current position in the ray
-    glm::vec3 rayPos = origin;
-
     // Step direction for each axis
     glm::ivec3 stepDir = glm::ivec3(
         rayDir.x > 0 ? 1 : -1,
@@ -519,31 +1201,28 @@ World::RaycastResult World::raycast(const glm::vec3& origin, const glm::vec3& di
     );
 
     // Current voxel position
-    glm::ivec3 voxelPos = glm::ivec3(glm::floor(rayPos));
-
-    // Calculate delta distances (distance to cross one voxel in each direction)
-    glm::vec3 deltaDist = glm::vec3(
-        rayDir.x == 0 ? 1e30f : std::abs(1.0f / rayDir.x),
-        rayDir.y == 0 ? 1e30f : std::abs(1.0f / rayDir.y),
-        rayDir.z == 0 ? 1e30f : std::abs(1.0f / rayDir.z)
+    glm::ivec3 voxelPos = glm::ivec3(glm::floor(origin));
+
+    // Distance along the ray to the boundary a voxel is left through on one axis. Always
+    // computed fresh from the origin (never accumulated), so the voxel steps and the empty-cell
+    // jumps below agree to the bit on which boundary the ray reaches first.
+    glm::vec3 invDir = glm::vec3(
+        rayDir.x == 0 ? 0.0f : 1.0f / rayDir.x,
+        rayDir.y == 0 ? 0.0f : 1.0f / rayDir.y,
+        rayDir.z == 0 ? 0.0f : 1.0f / rayDir.z
     );
+    auto boundaryDistance = [&](int axis, int voxel) {
+        if (rayDir[axis] == 0) {
+            return 1e30f;
+        }
+        float boundary = static_cast<float>(stepDir[axis] > 0 ? voxel + 1 : voxel);
+        return (boundary - origin[axis]) * invDir[axis];
+    };
 
     // Calculate initial side distances
     glm::vec3 sideDist;
-    if (rayDir.x < 0) {
-        sideDist.x = (rayPos.x - voxelPos.x) * deltaDist.x;
-    } else {
-        sideDist.x = (voxelPos.x + 1.0f - rayPos.x) * deltaDist.x;
-    }
-    if (rayDir.y < 0) {
-        sideDist.y = (rayPos.y - voxelPos.y) * deltaDist.y;
-    } else {
-        sideDist.y = (voxelPos.y + 1.0f - rayPos.y) * deltaDist.y;
-    }
-    if (rayDir.z < 0) {
-        sideDist.z = (rayPos.z - voxelPos.z) * deltaDist.z;
-    } else {
-        sideDist.z = (voxelPos.z + 1.0f - rayPos.z) * deltaDist.z;
+    for (int axis = 0; axis < 3; axis++) {
+        sideDist[axis] = boundaryDistance(axis, voxelPos[axis]);
     }
 
     // Track which side was hit (for calculating normals)
@@ -552,10 +1231,13 @@ World::RaycastResult World::raycast(const glm::vec3& origin, const glm::vec3& di
     // Previous voxel position (for placing blocks)
     glm::ivec3 prevVoxelPos = voxelPos;
 
+    // The cursor follows the ray, so only chunk crossings cost a chunk lookup
+    BlockCursor cursor(this, voxelPos);
+
     // Step through voxels
     float currentDistance = 0.0f;
     while (currentDistance < maxDistance) {        // Check if current voxel contains a solid block
-        BlockData block = getBlock(voxelPos.x, voxelPos.y, voxelPos.z);
+        BlockData block = cursor.get();
         if (block.type != BlockType::AIR) {
             // Hit a solid block
             result.hit = true;
@@ -582,27 +1264,80 @@ World::RaycastResult World::raycast(const glm::vec3& origin, const glm::vec3& di
             break;
         }
 
+        // Coarse level: inside an empty section (or an unloaded chunk, or above/below the
+        // column) jump straight to where the ray leaves that empty space
+        glm::ivec3 cellMin, cellMax;
+        if (findEmptyCell(cursor.getChunk(), voxelPos, cellMin, cellMax)) {
+            glm::vec3 exitDist;
+            for (int axis = 0; axis < 3; axis++) {
+                bool unbounded = stepDir[axis] > 0 ? cellMax[axis] == std::numeric_limits<int>::max()
+                                                   : cellMin[axis] == std::numeric_limits<int>::min();
+                if (rayDir[axis] == 0 || unbounded) {
+                    exitDist[axis] = std::numeric_limits<float>::infinity();
+                } else {
+                    exitDist[axis] = boundaryDistance(axis, stepDir[axis] > 0 ? cellMax[axis] : cellMin[axis]);
+                }
+            }
+
+            // Same tie-breaking as the voxel steps below
+            int exitAxis = (exitDist.x < exitDist.y && exitDist.x < exitDist.z) ? 0 : (exitDist.y < exitDist.z ? 1 : 2);
+            float exitDistance = exitDist[exitAxis];
+            if (exitDistance >= maxDistance) {
+                break;  // Nothing to hit before the ray runs out
+            }
+
+            // Enter the voxel just across the exit face. On the other axes land where the voxel
+            // steps would: a boundary at exactly exitDistance counts as crossed only if its axis
+            // wins the tie (the step order below favours z, then y), and the voxel stays in the cell
+            glm::vec3 exitPoint = origin + rayDir * exitDistance;
+            for (int axis = 0; axis < 3; axis++) {
+                if (axis == exitAxis) {
+                    voxelPos[axis] = stepDir[axis] > 0 ? cellMax[axis] + 1 : cellMin[axis] - 1;
+                } else if (rayDir[axis] != 0) {
+                    auto crossed = [&](float distance) {
+                        return distance < exitDistance || (distance == exitDistance && axis > exitAxis);
+                    };
+                    int first = stepDir[axis] > 0 ? cellMin[axis] : cellMax[axis];
+                    int last = stepDir[axis] > 0 ? cellMax[axis] : cellMin[axis];
+                    int voxel = glm::clamp(static_cast<int>(std::floor(exitPoint[axis])), cellMin[axis], cellMax[axis]);
+                    while (voxel != last && crossed(boundaryDistance(axis, voxel))) voxel += stepDir[axis];
+                    while (voxel != first && !crossed(boundaryDistance(axis, voxel - stepDir[axis]))) voxel -= stepDir[axis];
+                    voxelPos[axis] = voxel;
+                }
+                sideDist[axis] = boundaryDistance(axis, voxelPos[axis]);
+            }
+
+            prevVoxelPos = voxelPos;
+            cursor.moveTo(voxelPos.x, voxelPos.y, voxelPos.z);
+            currentDistance = std::max(currentDistance, exitDistance);
+            hitSide = exitAxis;
+            continue;
+        }
+
         // Store previous position for block placement
         prevVoxelPos = voxelPos;
 
         // Move to next voxel
         if (sideDist.x < sideDist.y && sideDist.x < sideDist.z) {
             // Step in X direction
-            sideDist.x += deltaDist.x;
+            currentDistance = sideDist.x;
             voxelPos.x += stepDir.x;
-            currentDistance = sideDist.x - deltaDist.x;
+            sideDist.x = boundaryDistance(0, voxelPos.x);
+            cursor.moveX(stepDir.x);
             hitSide = 0;
         } else if (sideDist.y < sideDist.z) {
             // Step in Y direction
-            sideDist.y += deltaDist.y;
+            currentDistance = sideDist.y;
             voxelPos.y += stepDir.y;
-            currentDistance = sideDist.y - deltaDist.y;
+            sideDist.y = boundaryDistance(1, voxelPos.y);
+            cursor.moveY(stepDir.y);
             hitSide = 1;
         } else {
             // Step in Z direction
-            sideDist.z += deltaDist.z;
+            currentDistance = sideDist.z;
             voxelPos.z += stepDir.z;
-            currentDistance = sideDist.z - deltaDist.z;
+            sideDist.z = boundaryDistance(2, voxelPos.z);
+            cursor.moveZ(stepDir.z);
             hitSide = 2;
         }
     }
@@ -647,7 +1382,7 @@ void World::initializeHighlightGeometry() {
     glBindVertexArray(0);
 }
 
-void World::renderBlockHighlight(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& /* cameraPos */) {
+void World::renderBlockHighlight(const glm::mat4& /* view */, const glm::mat4& /* projection */, const glm::vec3& /* cameraPos */) {
     if (!targetedBlockValid || !highlightShader) {
         return;
     }
@@ -660,9 +1395,8 @@ void World::renderBlockHighlight(const glm::mat4& view, const glm::mat4& project
     glDepthMask(GL_FALSE);
 
     // Use highlight shader
+    // View and projection come from the frame uniforms written by render()
     highlightShader->use();
-    highlightShader->setMatrix4("view", view);
-    highlightShader->setMatrix4("projection", projection);
 
     // Create model matrix for the targeted block
     glm::mat4 model = glm::translate(glm::mat4(1.0f),
@@ -693,8 +1427,23 @@ void World::clearTargetedBlock() {
 }
 
 void World::regenerateWorld(unsigned int newSeed) {
-    // Clear all existing chunks
+    // Save edits of the current world and let the I/O thread finish with the old seed
+    // (delta baselines are generated from the current noise), then clear all chunks
+    saveModifiedChunks();
+    if (initialized) {
+        closeChunkStorage();
+    }
+    for (auto& pair : chunks) {
+        chunkPool.release(std::move(pair.second));
+    }
     chunks.clear();
+    cullTree.clear();
+    blockVersion++;
+    chunkCache.clear();
+    memoryManager.clear();
+    visitedChunks.clear();
+    hasLastPlayerChunk = false;
+    farTerrain.invalidate();
 
     // Update the terrain settings with new seeds
     gTerrainSettings.baseSeed = newSeed;
@@ -707,6 +1456,11 @@ void World::regenerateWorld(unsigned int newSeed) {
     // This is done by calling a static reset function
     resetChunkNoiseGenerators();
 
+    // Switch persistence to the new seed's save directory
+    if (initialized) {
+        openChunkStorage();
+    }
+
     // Clear targeted block
     clearTargetedBlock();
 
@@ -1,16 +1,36 @@
 #pragma once
 
+#include "cave_culler.h"
 #include "chunk.h"
+#include "chunk_cache.h"
+#include "chunk_cull_tree.h"
+#include "chunk_pool.h"
+#include "far_terrain.h"
+#include "memory_manager.h"
+#include "worker_pool.h"
+#include "../renderer/frame_uniforms.h"
+#include "../renderer/occlusion_buffer.h"
+#include "../renderer/render_queue.h"
 #include "../renderer/simple_shader.h"
 #include "../utils/math_utils.h"
+#include <array>
 #include <unordered_map>
+#include <unordered_set>
+#include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <chrono>
 #include <glm/glm.hpp>
 
 #ifdef FASTNOISE_AVAILABLE
 #include "FastNoiseLite.h"
 #endif
 
+class ChunkStorage;
+class ChunkIOThread;
+class EditJournal;
+
 // Terrain generation settings structure
 struct TerrainSettings {
     float baseFrequency = 0.0015f;
@@ -25,6 +45,15 @@ struct TerrainSettings {
 // Global terrain settings instance
 inline TerrainSettings gTerrainSettings;
 
+// Accumulated chunk load latency for one load path
+struct ChunkLoadStats {
+    uint64_t count = 0;
+    double totalMs = 0.0;
+
+    void record(double ms) { count++; totalMs += ms; }
+    double averageMs() const { return count > 0 ? totalMs / static_cast<double>(count) : 0.0; }
+};
+
 class World {
 public:
     World();
@@ -43,11 +72,29 @@ public:
     void generateFlatChunk(ChunkCoord coord);    // Chunk management
     Chunk* getChunk(ChunkCoord coord);
     const Chunk* getChunk(ChunkCoord coord) const;
+    // Also usable before initialize(): a world of hand-filled chunks needs no GL context for
+    // block queries and raycasts
     void addChunk(ChunkCoord coord, std::unique_ptr<Chunk> chunk);// Rendering
     void render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos);    // Block access (world coordinates)
     BlockData getBlock(int x, int y, int z) const;
     void setBlock(int x, int y, int z, BlockData block);
 
+    // Bulk edits over an inclusive world-space box (corners in any order, loaded chunks only)
+    // Rows are written straight into chunk storage and each affected chunk is marked for
+    // remeshing once. A fill journals one box per chunk; replace and paste journal each
+    // changed block. Return the number of blocks that changed.
+    size_t fillRegion(const glm::ivec3& cornerA, const glm::ivec3& cornerB, BlockData block);
+    size_t replaceRegion(const glm::ivec3& cornerA, const glm::ivec3& cornerB, BlockData from, BlockData to);
+    // blocks holds size.x * size.y * size.z entries, y-major like chunk storage:
+    // index = (y * size.z + z) * size.x + x
+    size_t pasteRegion(const glm::ivec3& origin, const glm::ivec3& size, const std::vector<BlockData>& blocks);
+
+    // Terrain height queries straight from the generator (no chunk is generated or loaded)
+    // Returns the Y of the topmost terrain block; water above it and player edits are ignored
+    int getSurfaceHeight(int x, int z) const;
+    // Batch variant: fills a width x depth grid (row-major, z outer) starting at (x0, z0)
+    void getSurfaceHeights(int x0, int z0, int width, int depth, std::vector<int>& outHeights) const;
+
     // Dynamic chunk management
     void updateChunksAroundPlayer(const glm::vec3& playerPos);
     // Update dirty chunk meshes
@@ -56,10 +103,69 @@ public:
     void unloadChunk(ChunkCoord coord);
     bool isChunkLoaded(ChunkCoord coord) const;
 
+    // Persistence - queue every edited chunk for the I/O thread
+    void saveModifiedChunks();
+    // Block until queued saves are on disk
+    void flushChunkSaves();
+
+    // Save statistics (I/O thread)
+    int getSaveQueueDepth() const;
+    uint64_t getSaveBytesWritten() const;
+    uint64_t getSaveChunksWritten() const;
+    uint64_t getSavesCoalesced() const;
+    int getSaveSyncInterval() const;
+    void setSaveSyncInterval(int milliseconds);
+
+    // Edit journal statistics
+    uint64_t getJournalSize() const;
+    size_t getJournalPendingCount() const;
+
+    // Load latency: saved chunks read from region files (first visit this session vs revisit)
+    // against chunks generated from noise
+    const ChunkLoadStats& getColdDiskLoadStats() const { return coldDiskLoads; }
+    const ChunkLoadStats& getRevisitDiskLoadStats() const { return revisitDiskLoads; }
+    const ChunkLoadStats& getGeneratedLoadStats() const { return generatedLoads; }
+    const ChunkLoadStats& getCachedLoadStats() const { return cachedLoads; }
+
+    // Cache of recently unloaded chunks
+    const ChunkCache& getChunkCache() const { return chunkCache; }
+    void setChunkCacheBudget(size_t bytes) { chunkCache.setBudget(bytes); }
+
+    // Resident-memory budget - the farthest chunks are evicted and the load radius shrinks
+    // when blocks, GPU buffers and the chunk cache together exceed it
+    const MemoryManager& getMemoryManager() const { return memoryManager; }
+    const ChunkPool& getChunkPool() const { return chunkPool; }
+    void setMemoryBudget(size_t bytes) { memoryManager.setBudget(bytes); }
+    int getLoadRadius() const { return loadRadius; }
+
+    // Vertical streaming - when enabled, chunks mesh only the sections within verticalRadius
+    // sections of the player's height, so GPU memory and meshing follow the nearby volume
+    bool isVerticalStreaming() const { return verticalStreaming; }
+    void setVerticalStreaming(bool enabled);
+    int getVerticalRadius() const { return verticalRadius; }
+    void setVerticalRadius(int sections);
+
+    // Mesh level of detail - chunks at least getLodDistance(n) chunks from the player mesh at
+    // level n (2^n-block cells, see Chunk::setLodLevel); a distance of 0 disables that ring
+    bool isLodEnabled() const { return lodEnabled; }
+    void setLodEnabled(bool enabled);
+    int getLodDistance(int level) const { return lodDistances[level - 1]; }
+    void setLodDistances(int level1, int level2);
+
+    // Far terrain - a heightmap clipmap drawn beyond the loaded chunks (see FarTerrain)
+    bool isFarTerrainEnabled() const { return farTerrainEnabled; }
+    void setFarTerrainEnabled(bool enabled) { farTerrainEnabled = enabled; }
+    int getFarTerrainLevels() const { return farTerrain.getLevelCount(); }
+    void setFarTerrainLevels(int levels) { farTerrain.setLevelCount(levels); }
+    const FarTerrain& getFarTerrain() const { return farTerrain; }
+    // Distance to the edge of the visible world, in blocks (far terrain or loaded chunks)
+    float getHorizonDistance() const;
+
     // Neighbor notification system
     void notifyNeighborsOfNewChunk(ChunkCoord newChunkCoord);
 
     // Render distance management
+    static constexpr int MAX_RENDER_DISTANCE = 48;
     int getRenderDistance() const { return renderDistance; }
     void setRenderDistance(int distance);
     float getChunkUnloadDistance() const { return chunkUnloadDistance; }    // Chunk statistics
@@ -68,6 +174,27 @@ public:
     // Rendering statistics for optimization debugging
     int getRenderedChunkCount() const { return lastRenderedChunks; }
     int getCulledChunkCount() const { return lastCulledChunks; }
+    int getRenderedVertexCount() const { return lastRenderedVertices; }
+    // Rendered chunks at each mesh level of detail (0 = full resolution)
+    int getRenderedLodChunkCount(int level) const { return lastLodChunks[level]; }
+    // Culled chunks whose full-height column box would still have passed the frustum test
+    int getTightBoundsCulledChunkCount() const { return lastTightBoundsCulledChunks; }
+    // Frustum tests spent on the hierarchy plus individual chunks last frame
+    int getFrustumTestCount() const { return lastFrustumTests; }
+    // Software occlusion culling - frustum-visible chunks hidden behind the solid terrain of
+    // nearby chunks (rasterized into a small CPU depth buffer) are not drawn
+    bool isOcclusionCulling() const { return occlusionCulling; }
+    void setOcclusionCulling(bool enabled) { occlusionCulling = enabled; }
+    int getOccludedChunkCount() const { return lastOccludedChunks; }
+    int getOccluderCount() const { return lastOccluders; }
+    // Draws and state changes issued by the last render()
+    const RenderQueue::Stats& getRenderQueueStats() const { return renderQueue.getStats(); }
+    // Cave culling - chunks with no section reachable from the camera through open section
+    // faces (see CaveCuller) are not drawn
+    bool isCaveCulling() const { return caveCulling; }
+    void setCaveCulling(bool enabled) { caveCulling = enabled; }
+    int getCaveCulledChunkCount() const { return lastCaveCulledChunks; }
+    int getCaveVisitedSectionCount() const { return caveCuller.getVisitedSectionCount(); }
 
     // Player Interaction - Raycasting
     struct RaycastResult {
@@ -79,8 +206,31 @@ public:
         BlockData block;          // The block that was hit
         float distance;           // Distance from ray origin to hit
     };    // Cast a ray from camera position in camera direction to find targeted block
+    // Two-level DDA: empty sections and unloaded chunks are crossed in one jump, so long rays
+    // cost roughly one step per occupied voxel plus one per empty region
     RaycastResult raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = 10.0f) const;
 
+    // Batched raycasts for probes, hit validation and visibility sampling
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float maxDistance = 10.0f;
+    };
+    // Traces every ray with the same kernel as raycast(). Blocks until all rays are done; the
+    // world must not be modified meanwhile. results is resized to rays.size().
+    // maxThreads caps the threads used (0 = every hardware thread), and each thread gets at
+    // least MIN_RAYS_PER_THREAD rays: batches under 2 * MIN_RAYS_PER_THREAD run entirely on the
+    // calling thread, larger ones also use the World's persistent worker threads.
+    static constexpr size_t MIN_RAYS_PER_THREAD = 256;
+    void raycastBatch(const std::vector<Ray>& rays, std::vector<RaycastResult>& results, unsigned int maxThreads = 0) const;
+
+    // raycast() through a one-entry cache keyed on the exact ray, so the crosshair target,
+    // the block UI and click handling share one traversal per camera pose. Any block edit or
+    // chunk load/unload invalidates it. Main thread only.
+    RaycastResult raycastCached(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = 10.0f) const;
+    uint64_t getRaycastQueries() const { return raycastQueries; }
+    uint64_t getRaycastCacheHits() const { return raycastCacheHits; }
+
     // Block highlighting
     void renderBlockHighlight(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos);
     void setTargetedBlock(const glm::ivec3& blockPos);
@@ -88,7 +238,84 @@ public:
     bool hasTargetedBlock() const { return targetedBlockValid; }
 
 private:    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoord::Hash> chunks;
-    bool initialized;    // Performance constants
+    bool initialized;
+
+    // Region file persistence for edited chunks (one directory per seed)
+    std::unique_ptr<ChunkStorage> chunkStorage;
+    std::unique_ptr<ChunkIOThread> chunkIO;     // Writes snapshots off the render thread
+    int saveSyncIntervalMs;
+    static constexpr const char* SAVE_ROOT = "saves";
+    void openChunkStorage();
+    void closeChunkStorage();
+
+    // Write-ahead journal of block edits, group-committed by the I/O thread
+    std::unique_ptr<EditJournal> editJournal;
+    uint64_t editTick = 0;
+    static constexpr uint64_t JOURNAL_COMPACT_BYTES = 256 * 1024;
+    void replayEditJournal(const std::string& path);
+    void compactEditJournal();
+
+    // Bulk edit driver: calls editRow(row, count, worldX, y, worldZ) for every x-run of the box
+    // inside each loaded chunk (row points into chunk storage, editRow returns blocks changed),
+    // then onChunkEdited(minCorner, maxCorner) with the box clipped to each chunk that changed
+    template <typename RowEdit, typename ChunkEdited>
+    size_t editRegion(const glm::ivec3& cornerA, const glm::ivec3& cornerB, RowEdit editRow, ChunkEdited onChunkEdited);
+    void markNeighborsForRemesh(ChunkCoord coord, bool minX, bool maxX, bool minZ, bool maxZ);
+
+    // raycastBatch's helper threads, started on the first batch large enough to split
+    mutable WorkerPool raycastWorkers;
+
+    // Raycast coarse level: the box of guaranteed-air voxels around voxelPos (an unloaded column,
+    // the space above/below the column, or a run of empty sections), in inclusive world voxel
+    // coordinates with INT_MIN/INT_MAX for unbounded y. Returns false if voxelPos's section has blocks.
+    static bool findEmptyCell(const Chunk* chunk, const glm::ivec3& voxelPos, glm::ivec3& cellMin, glm::ivec3& cellMax);
+
+    // Region prefetch along the player's direction of travel
+    static constexpr int PREFETCH_CHUNKS = 4;   // How far ahead of the load radius to hint
+    ChunkCoord lastPlayerChunk;
+    bool hasLastPlayerChunk = false;
+    void prefetchAhead(const glm::vec3& playerPos);
+
+    // Recently unloaded chunks, checked before disk and generation
+    ChunkCache chunkCache;
+    // Unloaded Chunk objects (storage + GL handles) recycled by loadChunk
+    ChunkPool chunkPool;
+
+    // Memory budget enforcement
+    MemoryManager memoryManager;
+    int loadRadius;                             // <= renderDistance, shrinks under memory pressure
+    std::chrono::steady_clock::time_point lastRadiusChange;
+    static constexpr int MIN_LOAD_RADIUS = 2;
+    static constexpr float LOAD_RADIUS_REGROW_SECONDS = 5.0f;
+    bool memoryBudgetUnmet = false;             // Logged once until the budget is met again
+    void enforceMemoryBudget(const glm::vec3& playerPos);
+
+    // Vertical streaming window (section indices, inclusive), applied to every loaded chunk
+    bool verticalStreaming = false;
+    int verticalRadius = DEFAULT_VERTICAL_RADIUS;
+    int playerSection = 0;
+    int meshMinSection = 0;
+    int meshMaxSection = CurrentChunkGeometry::SECTION_COUNT - 1;
+    static constexpr int DEFAULT_VERTICAL_RADIUS = 4;
+    void updateVerticalWindow();
+
+    // Level-of-detail rings (Chebyshev chunk distance from lodCenter)
+    bool lodEnabled = true;
+    std::array<int, Chunk::MAX_LOD_LEVEL> lodDistances = {{DEFAULT_LOD1_DISTANCE, DEFAULT_LOD2_DISTANCE}};
+    ChunkCoord lodCenter;
+    static constexpr int DEFAULT_LOD1_DISTANCE = 8;
+    static constexpr int DEFAULT_LOD2_DISTANCE = 16;
+    int lodLevelFor(ChunkCoord coord) const;
+    void updateLodLevels();
+
+    // Load latency statistics
+    std::unordered_set<ChunkCoord, ChunkCoord::Hash> visitedChunks;
+    ChunkLoadStats coldDiskLoads;
+    ChunkLoadStats revisitDiskLoads;
+    ChunkLoadStats generatedLoads;
+    ChunkLoadStats cachedLoads;
+
+    // Performance constants
     static constexpr int DEFAULT_RENDER_DISTANCE = 12;
     static constexpr float CHUNK_UNLOAD_MULTIPLIER = 1.5f;
 
@@ -102,6 +329,7 @@ private:    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoord::H
 
     // Rendering components
     SimpleShader* blockShader;
+    SimpleShader* farTerrainShader;     // block.frag over world-space vertices with real normals
     SimpleShader* highlightShader;
     GLuint highlightVAO, highlightVBO;
 
@@ -118,10 +346,52 @@ private:    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoord::H
     FastNoiseLite domainWarpNoise;     // Domain warping for natural terrain
 #endif
 
+    // Shared raycast result - valid while the ray and blockVersion match
+    struct RaycastCacheEntry {
+        bool valid = false;
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float maxDistance = 0.0f;
+        uint64_t blockVersion = 0;
+        RaycastResult result;
+    };
+    mutable RaycastCacheEntry raycastCache;
+    mutable uint64_t raycastQueries = 0;
+    mutable uint64_t raycastCacheHits = 0;
+    uint64_t blockVersion = 0;      // Bumped whenever any block a ray could see changes
+
     // Optimization systems
     mutable MathUtils::Frustum viewFrustum;
     mutable int lastRenderedChunks = 0;
     mutable int lastCulledChunks = 0;
+    mutable int lastRenderedVertices = 0;
+    mutable std::array<int, Chunk::MAX_LOD_LEVEL + 1> lastLodChunks = {};
+    mutable int lastTightBoundsCulledChunks = 0;
+    mutable int lastFrustumTests = 0;
+    ChunkCullTree cullTree;                 // Mirrors the chunk map for hierarchical culling
+    std::vector<Chunk*> visibleChunks;      // Reused every frame
+
+    // Per-frame camera/light/fog block shared by the world's programs, and the frame's draws
+    FrameUniforms frameUniforms;
+    RenderQueue renderQueue;
+
+    // Far terrain
+    bool farTerrainEnabled = true;
+    FarTerrain farTerrain;
+
+    // Cave culling
+    bool caveCulling = true;
+    CaveCuller caveCuller;
+    mutable int lastCaveCulledChunks = 0;
+
+    // Occlusion culling
+    static constexpr int OCCLUDER_RADIUS = 4;   // Chunks this close to the camera act as occluders
+    bool occlusionCulling = true;
+    OcclusionBuffer occlusionBuffer;
+    mutable int lastOccludedChunks = 0;
+    mutable int lastOccluders = 0;
+    // Rasterize nearby chunks' occluder cells, then drop hidden chunks from visibleChunks
+    void cullOccludedChunks(const glm::mat4& viewProjection, const glm::vec3& cameraPos);
 
     // World settings
     int renderDistance;
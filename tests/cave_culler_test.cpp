@@ -0,0 +1,192 @@
+// Cave culling over hand-built tunnel worlds: section flood fill and the camera search
+#include "world/cave_culler.h"
+#include <iostream>
+#include <map>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+using Geometry = CurrentChunkGeometry;
+
+static constexpr int RADIUS = 3;
+static const glm::vec3 CAMERA(8.5f, 41.5f, 8.5f);    // Chunk (0, 0), section 2
+
+static Chunk::OpacityTable opacity() {
+    Chunk::OpacityTable opaque{};
+    opaque[static_cast<size_t>(BlockType::STONE)] = true;
+    return opaque;
+}
+
+// Solid stone over the whole search grid, with tunnels carved as inclusive world-space boxes
+class TestWorld {
+public:
+    TestWorld() {
+        for (int z = -RADIUS; z <= RADIUS; z++) {
+            for (int x = -RADIUS; x <= RADIUS; x++) {
+                blocks[ChunkCoord(x, z)].assign(BLOCKS_PER_CHUNK, BlockData(BlockType::STONE));
+            }
+        }
+    }
+
+    void carve(glm::ivec3 min, glm::ivec3 max) {
+        for (int y = min.y; y <= max.y; y++) {
+            for (int z = min.z; z <= max.z; z++) {
+                for (int x = min.x; x <= max.x; x++) {
+                    ChunkCoord coord = ChunkUtils::worldToChunkCoord(x, z);
+                    blocks[coord][Geometry::blockIndex(x - coord.x * CHUNK_WIDTH, y, z - coord.z * CHUNK_DEPTH)] =
+                        BlockData(BlockType::AIR);
+                }
+            }
+        }
+    }
+
+    uint16_t sectionConnectivity(ChunkCoord coord, int section) const {
+        return connectivity.at(coord)[section];
+    }
+
+    // Connectivity for every section, then one search from the camera with a frustum that
+    // holds the whole grid
+    void cull(CaveCuller& culler, const glm::vec3& camera) {
+        Chunk::OpacityTable opaque = opacity();
+        std::vector<int> stack;
+        for (const auto& entry : blocks) {
+            std::vector<uint16_t>& masks = connectivity[entry.first];
+            masks.resize(Geometry::SECTION_COUNT);
+            for (int section = 0; section < Geometry::SECTION_COUNT; section++) {
+                masks[section] = Chunk::computeSectionConnectivity(
+                    entry.second.data() + section * Geometry::SECTION_VOLUME, opaque, stack);
+            }
+        }
+
+        MathUtils::Frustum frustum;
+        frustum.updateFromMatrix(glm::ortho(-1000.0f, 1000.0f, -1000.0f, 1000.0f, -1000.0f, 1000.0f));
+        culler.update(camera, frustum, RADIUS, 0, Geometry::SECTION_COUNT - 1,
+                      [this](ChunkCoord coord) -> const uint16_t* {
+                          auto it = connectivity.find(coord);
+                          return it != connectivity.end() ? it->second.data() : nullptr;
+                      });
+    }
+
+private:
+    std::map<ChunkCoord, std::vector<BlockData>> blocks;
+    std::map<ChunkCoord, std::vector<uint16_t>> connectivity;
+};
+
+static void testSectionConnectivity() {
+    Chunk::OpacityTable opaque = opacity();
+    std::vector<int> stack;
+
+    std::vector<BlockData> section(Geometry::SECTION_VOLUME, BlockData(BlockType::AIR));
+    CHECK(Chunk::computeSectionConnectivity(section.data(), opaque, stack) == Chunk::ALL_FACES_CONNECTED);
+
+    section.assign(Geometry::SECTION_VOLUME, BlockData(BlockType::STONE));
+    CHECK(Chunk::computeSectionConnectivity(section.data(), opaque, stack) == 0);
+
+    // A tunnel along x joins only the two x faces
+    for (int x = 0; x < CHUNK_WIDTH; x++) {
+        section[Geometry::blockIndex(x, 5, 5)] = BlockData(BlockType::AIR);
+    }
+    CHECK(Chunk::computeSectionConnectivity(section.data(), opaque, stack) ==
+          Chunk::facePairBit(CubeFace::LEFT, CubeFace::RIGHT));
+
+    // A second, separate shaft from bottom to top adds its own pair but no cross pairs
+    for (int y = 0; y < Geometry::SECTION_HEIGHT; y++) {
+        section[Geometry::blockIndex(12, y, 12)] = BlockData(BlockType::AIR);
+    }
+    CHECK(Chunk::computeSectionConnectivity(section.data(), opaque, stack) ==
+          (Chunk::facePairBit(CubeFace::LEFT, CubeFace::RIGHT) | Chunk::facePairBit(CubeFace::TOP, CubeFace::BOTTOM)));
+}
+
+static void testStraightTunnel() {
+    TestWorld world;
+    world.carve(glm::ivec3(4, 40, 7), glm::ivec3(RADIUS * CHUNK_WIDTH + CHUNK_WIDTH - 1, 42, 9));
+    CaveCuller culler;
+    world.cull(culler, CAMERA);
+
+    CHECK(culler.isActive());
+    for (int x = 1; x <= RADIUS; x++) {
+        CHECK(culler.isSectionVisible(ChunkCoord(x, 0), 2));
+    }
+    // Rock walls next to the camera can be seen, rock beyond them cannot
+    CHECK(culler.isSectionVisible(ChunkCoord(0, 1), 2));
+    CHECK(culler.isSectionVisible(ChunkCoord(0, 0), 3));
+    CHECK(!culler.isSectionVisible(ChunkCoord(2, 1), 2));
+    CHECK(!culler.isSectionVisible(ChunkCoord(2, 0), 3));
+    CHECK(!culler.isSectionVisible(ChunkCoord(2, 0), 1));
+    CHECK(!culler.isSectionVisible(ChunkCoord(-2, 0), 2));
+    CHECK(!culler.isChunkVisible(ChunkCoord(0, 2)));
+}
+
+static void testLBend() {
+    TestWorld world;
+    world.carve(glm::ivec3(4, 40, 7), glm::ivec3(40, 42, 9));     // East into chunk (2, 0)
+    world.carve(glm::ivec3(38, 40, 7), glm::ivec3(40, 42, 40));   // Then south to chunk (2, 2)
+    CaveCuller culler;
+    world.cull(culler, CAMERA);
+
+    CHECK(world.sectionConnectivity(ChunkCoord(2, 0), 2) == Chunk::facePairBit(CubeFace::LEFT, CubeFace::FRONT));
+    CHECK(culler.isSectionVisible(ChunkCoord(1, 0), 2));
+    CHECK(culler.isSectionVisible(ChunkCoord(2, 0), 2));
+    CHECK(culler.isSectionVisible(ChunkCoord(2, 1), 2));
+    CHECK(culler.isSectionVisible(ChunkCoord(2, 2), 2));
+    // Past the bend the search only continues along the tunnel
+    CHECK(!culler.isSectionVisible(ChunkCoord(3, 0), 2));
+    CHECK(!culler.isSectionVisible(ChunkCoord(1, 1), 2));
+    CHECK(!culler.isSectionVisible(ChunkCoord(2, 3), 2));
+}
+
+static void testSealedPocket() {
+    TestWorld world;
+    world.carve(glm::ivec3(4, 40, 7), glm::ivec3(20, 42, 9));     // Dead end in chunk (1, 0)
+    world.carve(glm::ivec3(36, 36, 4), glm::ivec3(44, 44, 11));   // Air pocket inside chunk (2, 0)
+    CaveCuller culler;
+    world.cull(culler, CAMERA);
+
+    CHECK(world.sectionConnectivity(ChunkCoord(1, 0), 2) == 0);
+    CHECK(world.sectionConnectivity(ChunkCoord(2, 0), 2) == 0);
+    CHECK(culler.isSectionVisible(ChunkCoord(1, 0), 2));
+    CHECK(!culler.isSectionVisible(ChunkCoord(2, 0), 2));
+    CHECK(!culler.isChunkVisible(ChunkCoord(2, 0)));
+}
+
+static void testCameraInRock() {
+    TestWorld world;
+    CaveCuller culler;
+    world.cull(culler, CAMERA);
+
+    // Only the camera's section and its six neighbours are reached
+    CHECK(culler.getVisitedSectionCount() == 7);
+    CHECK(culler.isSectionVisible(ChunkCoord(1, 0), 2));
+    CHECK(culler.isSectionVisible(ChunkCoord(0, 0), 1));
+    CHECK(!culler.isSectionVisible(ChunkCoord(2, 0), 2));
+    CHECK(!culler.isSectionVisible(ChunkCoord(0, 0), 4));
+    CHECK(!culler.isChunkVisible(ChunkCoord(1, 1)));
+
+    // Above the world the search is off and everything counts as visible
+    world.cull(culler, glm::vec3(8.5f, CHUNK_HEIGHT + 10.0f, 8.5f));
+    CHECK(!culler.isActive());
+    CHECK(culler.isSectionVisible(ChunkCoord(2, 0), 2));
+}
+
+int main() {
+    testSectionConnectivity();
+    testStraightTunnel();
+    testLBend();
+    testSealedPocket();
+    testCameraInRock();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "cave_culler_test passed" << std::endl;
+    return 0;
+}
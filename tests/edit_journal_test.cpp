@@ -0,0 +1,169 @@
+// Edit journal group commit, torn-tail replay and replay over snapshots that already hold edits
+#include "world/edit_journal.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+static const std::string TEST_DIR = "edit_journal_test_data";
+static const ChunkCoord CHUNK(0, 0);
+
+static BlockData& blockAt(std::vector<BlockData>& blocks, int x, int y, int z) {
+    return blocks[CurrentChunkGeometry::blockIndex(x, y, z)];
+}
+
+// Replay the journal into one chunk the way World::replayEditJournal does
+static size_t replayInto(const std::string& path, std::vector<BlockData>& blocks) {
+    return EditJournal::replay(path, [&](const JournalRecord& record) {
+        record.applyTo(CHUNK, blocks.data());
+    });
+}
+
+// Block p starts as C. "Replace A with B" then "replace C with A" leaves p = A. A snapshot
+// taken after both already holds p = A, and replaying the journal over it must keep p = A.
+// World::replaceRegion journals each changed block as SET_BLOCK, which this mirrors.
+static void testReplaceOverLaterSnapshot() {
+    std::string path = TEST_DIR + "/replace.journal";
+    const BlockData A(BlockType::SAND), B(BlockType::WOOD), C(BlockType::STONE);
+
+    std::vector<BlockData> live(BLOCKS_PER_CHUNK, BlockData(BlockType::AIR));
+    blockAt(live, 1, 10, 1) = C;    // p
+    blockAt(live, 2, 10, 1) = A;    // q - the first replace does change this one
+    uint64_t tick = 0;
+    {
+        EditJournal journal(path);
+        auto replace = [&](BlockData from, BlockData to) {
+            for (int x = 0; x < 4; x++) {
+                BlockData& block = blockAt(live, x, 10, 1);
+                if (block != from) continue;
+                journal.append(JournalRecord::setBlock(x, 10, 1, from, to, tick++));
+                block = to;
+            }
+        };
+        replace(A, B);
+        replace(C, A);
+        journal.append(JournalRecord::fill(glm::ivec3(0, 20, 0), glm::ivec3(3, 21, 3), C, tick++));
+        journal.commit();
+    }
+    for (int z = 0; z <= 3; z++) {
+        for (int y = 20; y <= 21; y++) {
+            for (int x = 0; x <= 3; x++) {
+                blockAt(live, x, y, z) = C;
+            }
+        }
+    }
+    CHECK(blockAt(live, 1, 10, 1) == A);
+    CHECK(blockAt(live, 2, 10, 1) == B);
+
+    // Over the later snapshot
+    std::vector<BlockData> recovered = live;
+    CHECK(replayInto(path, recovered) == 3);
+    CHECK(recovered == live);
+
+    // And over the state before any of the edits
+    std::vector<BlockData> original(BLOCKS_PER_CHUNK, BlockData(BlockType::AIR));
+    blockAt(original, 1, 10, 1) = C;
+    blockAt(original, 2, 10, 1) = A;
+    CHECK(replayInto(path, original) == 3);
+    CHECK(original == live);
+
+    EditJournal::removeFiles(path);
+}
+
+static void testTornTail() {
+    std::string path = TEST_DIR + "/torn.journal";
+    {
+        EditJournal journal(path);
+        journal.append(JournalRecord::setBlock(0, 5, 0, BlockData(), BlockData(BlockType::DIRT), 0));
+        journal.append(JournalRecord::setBlock(1, 5, 0, BlockData(), BlockData(BlockType::DIRT), 1));
+        journal.commit();
+        journal.append(JournalRecord::setBlock(2, 5, 0, BlockData(), BlockData(BlockType::DIRT), 2));
+        journal.append(JournalRecord::fill(glm::ivec3(0, 6, 0), glm::ivec3(15, 6, 15), BlockData(BlockType::STONE), 3));
+        journal.commit();
+        CHECK(journal.getSize() == 2 * JOURNAL_GROUP_HEADER_SIZE + 4 * JOURNAL_RECORD_SIZE);
+    }
+
+    std::vector<BlockData> blocks(BLOCKS_PER_CHUNK);
+    CHECK(replayInto(path, blocks) == 4);
+
+    // Crash in the middle of the second group: only the first group replays
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 7);
+    blocks.assign(BLOCKS_PER_CHUNK, BlockData());
+    CHECK(replayInto(path, blocks) == 2);
+    CHECK(blockAt(blocks, 1, 5, 0) == BlockData(BlockType::DIRT));
+    CHECK(blockAt(blocks, 2, 5, 0) == BlockData());
+    CHECK(blockAt(blocks, 0, 6, 0) == BlockData());
+
+    // A complete group whose records do not match its checksum is treated the same way
+    {
+        EditJournal journal(path + ".2");
+        journal.append(JournalRecord::setBlock(0, 5, 0, BlockData(), BlockData(BlockType::DIRT), 0));
+        journal.commit();
+        journal.append(JournalRecord::setBlock(1, 5, 0, BlockData(), BlockData(BlockType::DIRT), 1));
+        journal.commit();
+    }
+    std::FILE* file = std::fopen((path + ".2").c_str(), "r+b");
+    CHECK(file != nullptr);
+    if (file) {
+        uint8_t flipped = 0xFF;
+        std::fseek(file, static_cast<long>(2 * JOURNAL_GROUP_HEADER_SIZE + JOURNAL_RECORD_SIZE + 1), SEEK_SET);
+        std::fwrite(&flipped, 1, 1, file);
+        std::fclose(file);
+    }
+    blocks.assign(BLOCKS_PER_CHUNK, BlockData());
+    CHECK(replayInto(path + ".2", blocks) == 1);
+
+    EditJournal::removeFiles(path);
+    EditJournal::removeFiles(path + ".2");
+}
+
+static void testRotation() {
+    std::string path = TEST_DIR + "/rotate.journal";
+    {
+        EditJournal journal(path);
+        journal.append(JournalRecord::setBlock(0, 5, 0, BlockData(), BlockData(BlockType::DIRT), 0));
+        journal.commit();
+        journal.append(JournalRecord::setBlock(0, 5, 0, BlockData(BlockType::DIRT), BlockData(BlockType::SAND), 1));
+        CHECK(journal.rotate());
+        CHECK(!journal.rotate());
+        journal.append(JournalRecord::setBlock(0, 5, 0, BlockData(BlockType::SAND), BlockData(BlockType::WOOD), 2));
+        journal.commit();
+        CHECK(journal.isCompacting());
+    }
+
+    // An interrupted compaction replays the retired file first
+    CHECK(std::filesystem::exists(path + ".old"));
+    std::vector<BlockData> blocks(BLOCKS_PER_CHUNK);
+    CHECK(replayInto(path, blocks) == 3);
+    CHECK(blockAt(blocks, 0, 5, 0) == BlockData(BlockType::WOOD));
+
+    EditJournal::removeFiles(path);
+}
+
+int main() {
+    std::filesystem::remove_all(TEST_DIR);
+    std::filesystem::create_directories(TEST_DIR);
+
+    testReplaceOverLaterSnapshot();
+    testTornTail();
+    testRotation();
+
+    std::filesystem::remove_all(TEST_DIR);
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "edit_journal_test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Batched frustum test: the SSE path must produce exactly the scalar path's masks
+#include "utils/math_utils.h"
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+// Both batched paths, checked against each other and against containsAABB per box
+static void checkBatch(const MathUtils::Frustum& frustum, const MathUtils::AABBBatch& boxes) {
+    std::vector<uint32_t> simd, scalar;
+    frustum.containsAABBs(boxes, simd);
+    frustum.containsAABBsScalar(boxes, scalar);
+    CHECK(simd.size() == (boxes.size() + 31) / 32);
+    CHECK(simd == scalar);
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+        glm::vec3 min(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+        glm::vec3 max(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+        bool bit = (scalar[i / 32] >> (i % 32)) & 1u;
+        if (bit != frustum.containsAABB(min, max)) {
+            CHECK(bit == frustum.containsAABB(min, max));
+            break;
+        }
+    }
+}
+
+static MathUtils::Frustum randomFrustum(std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> fov(30.0f, 110.0f);
+    glm::vec3 eye(position(rng), position(rng) * 0.5f + 64.0f, position(rng));
+    glm::vec3 target(position(rng), position(rng) * 0.5f, position(rng));
+    glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(fov(rng)), 16.0f / 9.0f, 0.1f, 300.0f);
+
+    MathUtils::Frustum frustum;
+    frustum.updateFromMatrix(projection * view);
+    return frustum;
+}
+
+// Random frusta and boxes, over batch sizes that leave 0-3 boxes for the scalar tail and
+// that do and do not fill whole mask words
+static void testRandomBatches() {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> corner(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> extent(0.0f, 40.0f);
+    const size_t sizes[] = {0, 1, 2, 3, 4, 5, 7, 31, 32, 33, 63, 64, 65, 127, 1001};
+
+    for (int round = 0; round < 20; round++) {
+        MathUtils::Frustum frustum = randomFrustum(rng);
+        for (size_t size : sizes) {
+            MathUtils::AABBBatch boxes;
+            for (size_t i = 0; i < size; i++) {
+                glm::vec3 min(corner(rng), corner(rng) * 0.5f + 64.0f, corner(rng));
+                boxes.add(min, min + glm::vec3(extent(rng), extent(rng), extent(rng)));
+            }
+            checkBatch(frustum, boxes);
+        }
+    }
+}
+
+// Boxes centered on a frustum plane, and boxes whose nearest face lies exactly on one
+static void testStraddlingBoxes() {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> extent(0.01f, 8.0f);
+
+    for (int round = 0; round < 20; round++) {
+        MathUtils::Frustum frustum = randomFrustum(rng);
+        MathUtils::AABBBatch boxes;
+        for (const glm::vec4& plane : frustum.planes) {
+            glm::vec3 normal(plane);
+            float length = glm::length(normal);
+            for (int i = 0; i < 11; i++) {
+                // A point on the plane, then a box around it, slightly off it, or just touching it
+                glm::vec3 onPlane = -normal * (plane.w / (length * length)) +
+                                    glm::cross(normal, glm::vec3(unit(rng), unit(rng), unit(rng))) * 50.0f;
+                glm::vec3 half(extent(rng), extent(rng), extent(rng));
+                boxes.add(onPlane - half, onPlane + half);
+                boxes.add(onPlane - half * 0.001f, onPlane + half * 0.001f);
+                boxes.add(onPlane, onPlane);
+            }
+        }
+        checkBatch(frustum, boxes);
+    }
+
+    // Axis-aligned planes make exact touching representable: a box ending on x = -10 has
+    // distance 0 to the left plane and counts as inside on both paths
+    MathUtils::Frustum box;
+    box.updateFromMatrix(glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, -10.0f, 10.0f));
+    MathUtils::AABBBatch boxes;
+    boxes.add(glm::vec3(-20.0f, -1.0f, -1.0f), glm::vec3(-10.0f, 1.0f, 1.0f));
+    boxes.add(glm::vec3(-20.0f, -1.0f, -1.0f), glm::vec3(-10.5f, 1.0f, 1.0f));
+    boxes.add(glm::vec3(10.0f, -1.0f, -1.0f), glm::vec3(20.0f, 1.0f, 1.0f));
+    boxes.add(glm::vec3(10.5f, -1.0f, -1.0f), glm::vec3(20.0f, 1.0f, 1.0f));
+    boxes.add(glm::vec3(-1.0f, 10.0f, -1.0f), glm::vec3(1.0f, 20.0f, 1.0f));
+    checkBatch(box, boxes);
+
+    std::vector<uint32_t> mask;
+    box.containsAABBs(boxes, mask);
+    CHECK(mask.size() == 1 && mask[0] == 0x15u);
+}
+
+int main() {
+    testRandomBatches();
+    testStraddlingBoxes();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "frustum_batch_test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,46 @@
+// Times Frustum::containsAABBs (SSE) against containsAABBsScalar over chunk-sized boxes
+// Not a ctest - run it by hand from a Release build: frustum_benchmark [boxes] [repeats]
+#include "utils/math_utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+template <typename Function>
+static double nanosecondsPerBox(Function function, size_t boxes, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++) {
+        function();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (static_cast<double>(boxes) * repeats);
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 4096;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    // A render-distance-16 window of 16 x 256 x 16 columns around a camera looking along +x
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> chunk(-16, 16);
+    MathUtils::AABBBatch boxes;
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 min(chunk(rng) * 16.0f, 0.0f, chunk(rng) * 16.0f);
+        boxes.add(min, min + glm::vec3(16.0f, 256.0f, 16.0f));
+    }
+
+    MathUtils::Frustum frustum;
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 80.0f, 0.0f), glm::vec3(1.0f, 80.0f, 0.2f), glm::vec3(0.0f, 1.0f, 0.0f));
+    frustum.updateFromMatrix(glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 512.0f) * view);
+
+    std::vector<uint32_t> simdMask, scalarMask;
+    double simd = nanosecondsPerBox([&] { frustum.containsAABBs(boxes, simdMask); }, count, repeats);
+    double scalar = nanosecondsPerBox([&] { frustum.containsAABBsScalar(boxes, scalarMask); }, count, repeats);
+
+    std::cout << count << " boxes x " << repeats << " repeats\n"
+              << "  containsAABBs:       " << simd << " ns/box\n"
+              << "  containsAABBsScalar: " << scalar << " ns/box\n"
+              << "  speedup:             " << scalar / simd << "x" << std::endl;
+    return simdMask == scalarMask ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+// Memory budget eviction: farthest chunks first, never the ones around the player
+#include "world/memory_manager.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+static constexpr int GRID = 5;                          // Chunks -GRID..GRID on both axes
+static const glm::vec3 PLAYER(8.0f, 64.0f, 8.0f);       // Center of chunk (0, 0)
+static const float KEEP_DISTANCE = 2 * CHUNK_WIDTH + CHUNK_WIDTH / 2.0f;
+
+static void trackGrid(MemoryManager& memory) {
+    for (int z = -GRID; z <= GRID; z++) {
+        for (int x = -GRID; x <= GRID; x++) {
+            Chunk chunk(ChunkCoord(x, z));
+            memory.trackChunk(chunk);
+        }
+    }
+}
+
+static size_t chunkBytes() {
+    return Chunk(ChunkCoord(0, 0)).getBlockBytes();
+}
+
+static void testFarthestFirst() {
+    MemoryManager memory;
+    trackGrid(memory);
+    size_t total = memory.getTotalBytes();
+    CHECK(total == (2 * GRID + 1) * (2 * GRID + 1) * chunkBytes());
+
+    memory.setBudget(total / 2);
+    CHECK(memory.isOverBudget());
+    std::vector<ChunkCoord> victims = memory.selectEvictions(PLAYER, KEEP_DISTANCE);
+
+    // Just enough to get under the low-water mark, in order of decreasing distance
+    CHECK(total - victims.size() * chunkBytes() <= memory.getLowWaterBytes());
+    CHECK(total - (victims.size() - 1) * chunkBytes() > memory.getLowWaterBytes());
+    for (size_t i = 1; i < victims.size(); i++) {
+        CHECK(ChunkUtils::chunkDistanceToPoint(victims[i - 1], PLAYER) >=
+              ChunkUtils::chunkDistanceToPoint(victims[i], PLAYER));
+    }
+}
+
+// Fixed bytes alone over the budget: everything but the chunks around the player goes
+static void testFixedBytesOverBudget() {
+    MemoryManager memory;
+    trackGrid(memory);
+    memory.setBudget(chunkBytes());
+    memory.setPoolBytes(4 * chunkBytes());
+    memory.setMeshBytes(chunkBytes());
+
+    std::vector<ChunkCoord> victims = memory.selectEvictions(PLAYER, KEEP_DISTANCE);
+    size_t kept = 0;
+    for (int z = -GRID; z <= GRID; z++) {
+        for (int x = -GRID; x <= GRID; x++) {
+            if (ChunkUtils::chunkDistanceToPoint(ChunkCoord(x, z), PLAYER) <= KEEP_DISTANCE) {
+                kept++;
+            }
+        }
+    }
+    CHECK(kept > 0);
+    CHECK(victims.size() + kept == static_cast<size_t>((2 * GRID + 1) * (2 * GRID + 1)));
+    for (const ChunkCoord& coord : victims) {
+        CHECK(ChunkUtils::chunkDistanceToPoint(coord, PLAYER) > KEEP_DISTANCE);
+    }
+
+    // After evicting them the budget is still not met, and nothing more is offered
+    for (const ChunkCoord& coord : victims) {
+        memory.untrackChunk(coord);
+    }
+    CHECK(memory.isOverBudget());
+    CHECK(memory.selectEvictions(PLAYER, KEEP_DISTANCE).empty());
+}
+
+int main() {
+    testFarthestFirst();
+    testFixedBytesOverBudget();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "memory_manager_test passed" << std::endl;
+    return 0;
+}
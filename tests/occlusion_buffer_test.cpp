@@ -0,0 +1,82 @@
+// Software occlusion buffer: occluder rasterization and conservative candidate tests
+#include "renderer/occlusion_buffer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+// Camera at the origin looking down -z; at distance d the screen spans x in [-2d, 2d] and
+// y in [-d, d] (90 degree vertical field of view on the default 2:1 buffer)
+static glm::mat4 viewProjection() {
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 2.0f, OcclusionBuffer::NEAR_W, 1000.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+
+static void testEmptyBuffer() {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+    CHECK(buffer.getOccluderCount() == 0);
+    CHECK(buffer.isVisible(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -19.0f)));
+}
+
+static void testWall() {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+
+    // A wall 10 blocks away covering the whole screen
+    CHECK(buffer.addOccluder(glm::vec3(-50.0f, -50.0f, -11.0f), glm::vec3(50.0f, 50.0f, -10.0f)));
+    CHECK(buffer.getOccluderCount() == 1);
+    CHECK(buffer.getDepth(buffer.getWidth() / 2, buffer.getHeight() / 2) == 11.0f);
+
+    // Behind the wall
+    CHECK(!buffer.isVisible(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -19.0f)));
+    // In front of the wall
+    CHECK(buffer.isVisible(glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -4.0f)));
+    // Reaching through the wall towards the camera
+    CHECK(buffer.isVisible(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -9.0f)));
+    // Crossing the near plane, with corners behind the camera
+    CHECK(buffer.isVisible(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, 1.0f)));
+
+    // Behind the wall and crossing the right screen edge: the on-screen part is hidden and
+    // the rest cannot be seen
+    CHECK(!buffer.isVisible(glm::vec3(0.0f, -1.0f, -21.0f), glm::vec3(100.0f, 1.0f, -19.0f)));
+    // Entirely off-screen boxes are left to the frustum test
+    CHECK(buffer.isVisible(glm::vec3(200.0f, -1.0f, -21.0f), glm::vec3(210.0f, 1.0f, -19.0f)));
+}
+
+static void testPartialOccluder() {
+    OcclusionBuffer buffer;
+    buffer.begin(viewProjection());
+
+    // A pillar covering the middle of the screen only
+    CHECK(buffer.addOccluder(glm::vec3(-2.0f, -50.0f, -11.0f), glm::vec3(2.0f, 50.0f, -10.0f)));
+    CHECK(!buffer.isVisible(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -19.0f)));
+    // Wider than the pillar's shadow
+    CHECK(buffer.isVisible(glm::vec3(-10.0f, -1.0f, -21.0f), glm::vec3(10.0f, 1.0f, -19.0f)));
+
+    // Occluders crossing the near plane are skipped rather than drawn at a guessed depth
+    CHECK(!buffer.addOccluder(glm::vec3(-50.0f, -50.0f, -5.0f), glm::vec3(50.0f, 50.0f, 1.0f)));
+    CHECK(buffer.getOccluderCount() == 1);
+}
+
+int main() {
+    testEmptyBuffer();
+    testWall();
+    testPartialOccluder();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "occlusion_buffer_test passed" << std::endl;
+    return 0;
+}
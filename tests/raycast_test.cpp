@@ -0,0 +1,270 @@
+// World::raycast's empty-cell skipping must hit the same block and face as per-voxel stepping
+#include "world/world.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+using Geometry = CurrentChunkGeometry;
+
+static constexpr int GRID = 2;                       // Chunks -GRID..GRID on both axes
+static const ChunkCoord UNLOADED(1, -1);             // A hole in the loaded area
+
+// Per-voxel DDA through World::getBlock: the same boundary distances and tie order as
+// World::raycast, but every voxel is visited
+static World::RaycastResult referenceRaycast(const World& world, const glm::vec3& origin,
+                                             const glm::vec3& direction, float maxDistance) {
+    World::RaycastResult result;
+    result.hit = false;
+    result.distance = maxDistance;
+
+    glm::vec3 rayDir = glm::normalize(direction);
+    glm::ivec3 stepDir(rayDir.x > 0 ? 1 : -1, rayDir.y > 0 ? 1 : -1, rayDir.z > 0 ? 1 : -1);
+    glm::ivec3 voxelPos = glm::ivec3(glm::floor(origin));
+    auto boundaryDistance = [&](int axis, int voxel) {
+        if (rayDir[axis] == 0) {
+            return 1e30f;
+        }
+        float boundary = static_cast<float>(stepDir[axis] > 0 ? voxel + 1 : voxel);
+        return (boundary - origin[axis]) * (1.0f / rayDir[axis]);
+    };
+    glm::vec3 sideDist;
+    for (int axis = 0; axis < 3; axis++) {
+        sideDist[axis] = boundaryDistance(axis, voxelPos[axis]);
+    }
+
+    int hitSide = 0;
+    float currentDistance = 0.0f;
+    while (currentDistance < maxDistance) {
+        BlockData block = world.getBlock(voxelPos.x, voxelPos.y, voxelPos.z);
+        if (block.type != BlockType::AIR) {
+            result.hit = true;
+            result.blockPos = voxelPos;
+            result.block = block;
+            result.distance = currentDistance;
+            result.hitPoint = origin + rayDir * currentDistance;
+            result.normal = glm::vec3(0.0f);
+            result.normal[hitSide] = stepDir[hitSide] > 0 ? -1.0f : 1.0f;
+            result.adjacentPos = result.blockPos + glm::ivec3(result.normal);
+            break;
+        }
+
+        int axis = (sideDist.x < sideDist.y && sideDist.x < sideDist.z) ? 0 : (sideDist.y < sideDist.z ? 1 : 2);
+        currentDistance = sideDist[axis];
+        voxelPos[axis] += stepDir[axis];
+        sideDist[axis] = boundaryDistance(axis, voxelPos[axis]);
+        hitSide = axis;
+    }
+    return result;
+}
+
+// Mostly empty sections, so rays cross long runs of air cells, with:
+//  - a stone floor (section 0) everywhere
+//  - sparse random blocks in sections 2 and 5 of some chunks
+//  - a dense section straddling y = 64 in chunk (0, 0)
+//  - a pillar in chunk (2, -1), behind the unloaded column
+static void buildWorld(World& world) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> local(0, Geometry::WIDTH - 1);
+    std::uniform_int_distribution<int> inSection(0, Geometry::SECTION_HEIGHT - 1);
+
+    for (int chunkZ = -GRID; chunkZ <= GRID; chunkZ++) {
+        for (int chunkX = -GRID; chunkX <= GRID; chunkX++) {
+            ChunkCoord coord(chunkX, chunkZ);
+            if (coord == UNLOADED) continue;
+
+            auto chunk = std::make_unique<Chunk>(coord, &world);
+            BlockData* blocks = chunk->getBlockData();
+            for (int y = 0; y < 4; y++) {
+                for (int z = 0; z < Geometry::DEPTH; z++) {
+                    for (int x = 0; x < Geometry::WIDTH; x++) {
+                        blocks[Geometry::blockIndex(x, y, z)] = BlockData(BlockType::STONE);
+                    }
+                }
+            }
+            if ((chunkX + chunkZ) % 2 == 0) {
+                for (int section : {2, 5}) {
+                    for (int i = 0; i < 12; i++) {
+                        int y = section * Geometry::SECTION_HEIGHT + inSection(rng);
+                        blocks[Geometry::blockIndex(local(rng), y, local(rng))] = BlockData(BlockType::WOOD);
+                    }
+                }
+            }
+            if (chunkX == 0 && chunkZ == 0) {
+                for (int y = 60; y < 68; y++) {
+                    for (int z = 4; z < 12; z++) {
+                        for (int x = 4; x < 12; x++) {
+                            blocks[Geometry::blockIndex(x, y, z)] = BlockData(BlockType::COBBLESTONE);
+                        }
+                    }
+                }
+            }
+            if (chunkX == 2 && chunkZ == -1) {
+                for (int y = 4; y < 120; y++) {
+                    blocks[Geometry::blockIndex(8, y, 8)] = BlockData(BlockType::SAND);
+                }
+            }
+            chunk->recountSections();
+            world.addChunk(coord, std::move(chunk));
+        }
+    }
+}
+
+static int mismatches = 0;
+
+static void compare(const World& world, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+    World::RaycastResult fast = world.raycast(origin, direction, maxDistance);
+    World::RaycastResult reference = referenceRaycast(world, origin, direction, maxDistance);
+
+    bool same = fast.hit == reference.hit;
+    if (same && fast.hit) {
+        same = fast.blockPos == reference.blockPos && fast.normal == reference.normal &&
+               fast.adjacentPos == reference.adjacentPos && fast.block == reference.block &&
+               std::abs(fast.distance - reference.distance) <= 1e-3f * std::max(1.0f, reference.distance);
+    }
+    if (!same) {
+        // Report the first few rays in full; the count is checked at the end of each test
+        if (mismatches++ < 5) {
+            std::cerr << "ray (" << origin.x << ", " << origin.y << ", " << origin.z << ") dir ("
+                      << direction.x << ", " << direction.y << ", " << direction.z << "): hit "
+                      << fast.hit << "/" << reference.hit << " block (" << fast.blockPos.x << ", "
+                      << fast.blockPos.y << ", " << fast.blockPos.z << ") vs (" << reference.blockPos.x << ", "
+                      << reference.blockPos.y << ", " << reference.blockPos.z << ")" << std::endl;
+        }
+    }
+}
+
+static void testRandomRays(const World& world) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> horizontal(-GRID * 16.0f, (GRID + 1) * 16.0f);
+    std::uniform_real_distribution<float> height(-10.0f, 140.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    mismatches = 0;
+    for (int i = 0; i < 20000; i++) {
+        glm::vec3 direction(unit(rng), unit(rng), unit(rng));
+        if (glm::length(direction) < 0.01f) continue;
+        compare(world, glm::vec3(horizontal(rng), height(rng), horizontal(rng)), direction, 120.0f);
+    }
+    CHECK(mismatches == 0);
+}
+
+// Long rays from high above and along empty sections, across the unloaded column
+static void testEmptyCells(const World& world) {
+    mismatches = 0;
+    compare(world, glm::vec3(0.5f, 200.0f, 0.5f), glm::vec3(0.3f, -1.0f, 0.2f), 300.0f);
+    compare(world, glm::vec3(-30.5f, 250.0f, 20.5f), glm::vec3(1.0f, -0.4f, -0.7f), 400.0f);
+    compare(world, glm::vec3(-40.0f, 100.0f, -8.0f), glm::vec3(1.0f, 0.0f, 0.0f), 200.0f);
+    // Through the unloaded column (1, -1) onto the pillar at (40, y, -8)
+    compare(world, glm::vec3(8.5f, 50.5f, -7.5f), glm::vec3(1.0f, 0.0f, 0.0f), 100.0f);
+    compare(world, glm::vec3(8.5f, 90.5f, -15.5f), glm::vec3(1.0f, -0.01f, 0.25f), 100.0f);
+    // Starting below and above the column
+    compare(world, glm::vec3(3.5f, -20.0f, 3.5f), glm::vec3(0.1f, 1.0f, 0.0f), 100.0f);
+    compare(world, glm::vec3(3.5f, 300.0f, 3.5f), glm::vec3(0.0f, -1.0f, 0.1f), 400.0f);
+
+    World::RaycastResult pillar = world.raycast(glm::vec3(8.5f, 50.5f, -7.5f), glm::vec3(1.0f, 0.0f, 0.0f), 100.0f);
+    CHECK(pillar.hit && pillar.blockPos == glm::ivec3(40, 50, -8) && pillar.normal == glm::vec3(-1.0f, 0.0f, 0.0f));
+    CHECK(mismatches == 0);
+}
+
+// Rays lying in or crossing cell boundaries exactly: section planes, chunk borders and
+// voxel edges and corners
+static void testGrazingRays(const World& world) {
+    mismatches = 0;
+    const glm::vec3 directions[] = {
+        {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, -1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {0.0f, -1.0f, 1.0f}, {1.0f, -1.0f, 1.0f},
+        {-1.0f, -1.0f, -1.0f}, {2.0f, -1.0f, 0.0f}, {1.0f, -2.0f, 2.0f},
+    };
+    for (float y : {16.0f, 32.0f, 48.0f, 64.0f, 80.0f, 96.0f}) {
+        for (float border : {-16.0f, 0.0f, 16.0f, 32.0f}) {
+            for (const glm::vec3& direction : directions) {
+                compare(world, glm::vec3(border, y, 0.0f), direction, 150.0f);
+                compare(world, glm::vec3(-20.0f, y, border), direction, 150.0f);
+                compare(world, glm::vec3(border, y, border), direction, 150.0f);
+                compare(world, glm::vec3(border + 0.5f, y, border + 0.5f), direction, 150.0f);
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+// Rays starting inside a section that has blocks, and inside a solid block
+static void testStartInsideSolidCell(const World& world) {
+    mismatches = 0;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> section(32.0f, 48.0f);
+    std::uniform_real_distribution<float> horizontal(-GRID * 16.0f, (GRID + 1) * 16.0f);
+    for (int i = 0; i < 2000; i++) {
+        compare(world, glm::vec3(horizontal(rng), section(rng), horizontal(rng)),
+                glm::vec3(unit(rng), unit(rng), unit(rng)), 80.0f);
+    }
+    // Inside the floor and inside the cobblestone block
+    compare(world, glm::vec3(5.5f, 2.5f, 5.5f), glm::vec3(0.0f, 1.0f, 0.3f), 50.0f);
+    compare(world, glm::vec3(8.5f, 64.5f, 8.5f), glm::vec3(1.0f, 0.2f, 0.0f), 50.0f);
+
+    World::RaycastResult inside = world.raycast(glm::vec3(8.5f, 64.5f, 8.5f), glm::vec3(1.0f, 0.2f, 0.0f), 50.0f);
+    CHECK(inside.hit && inside.distance == 0.0f && inside.blockPos == glm::ivec3(8, 64, 8));
+    CHECK(mismatches == 0);
+}
+
+// raycastBatch must return exactly what raycast does, on the calling thread alone and split
+// across the persistent workers (run twice so the second batch reuses them)
+static void testBatch(const World& world) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> horizontal(-GRID * 16.0f, (GRID + 1) * 16.0f);
+    std::uniform_real_distribution<float> height(0.0f, 120.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    for (size_t count : {size_t(1), World::MIN_RAYS_PER_THREAD, 8 * World::MIN_RAYS_PER_THREAD + 3}) {
+        std::vector<World::Ray> rays(count);
+        for (World::Ray& ray : rays) {
+            ray.origin = glm::vec3(horizontal(rng), height(rng), horizontal(rng));
+            ray.direction = glm::vec3(unit(rng), unit(rng) - 0.5f, unit(rng));
+            ray.maxDistance = 80.0f;
+        }
+        for (unsigned int maxThreads : {0u, 4u, 4u}) {
+            std::vector<World::RaycastResult> results;
+            world.raycastBatch(rays, results, maxThreads);
+            CHECK(results.size() == count);
+            size_t different = 0;
+            for (size_t i = 0; i < count; i++) {
+                World::RaycastResult single = world.raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance);
+                if (results[i].hit != single.hit || (single.hit && (results[i].blockPos != single.blockPos ||
+                                                                    results[i].distance != single.distance))) {
+                    different++;
+                }
+            }
+            CHECK(different == 0);
+        }
+    }
+}
+
+int main() {
+    World world;
+    buildWorld(world);
+
+    testRandomRays(world);
+    testEmptyCells(world);
+    testGrazingRays(world);
+    testStartInsideSolidCell(world);
+    testBatch(world);
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "raycast_test passed" << std::endl;
+    return 0;
+}
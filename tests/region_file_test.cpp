@@ -0,0 +1,300 @@
+// Region file and chunk codec round trips, sector reuse, corrupt-payload rejection and save.info checks
+#include "world/region_file.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                 \
+    do {                                                                                 \
+        if (!(condition)) {                                                              \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            failures++;                                                                  \
+        }                                                                                \
+    } while (0)
+
+static const std::string TEST_DIR = "region_file_test_data";
+static constexpr uint32_t TEST_SEED = 1337;
+
+static std::vector<BlockData> generated(ChunkCoord coord) {
+    std::vector<BlockData> blocks(BLOCKS_PER_CHUNK);
+    Chunk::generateBlocks(coord, blocks.data());
+    return blocks;
+}
+
+static uintmax_t fileSize(const std::string& path) {
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(path, error);
+    return error ? 0 : size;
+}
+
+// Payload tag of a saved chunk, read back through a second handle on the region file
+static bool storedCompression(const std::string& directory, ChunkCoord coord, RegionCompression& compression) {
+    ChunkCoord region = RegionFile::chunkToRegion(coord);
+    RegionFile file(directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.z) + ".mcr");
+    int index = RegionFile::chunkToLocalIndex(coord);
+    std::vector<uint8_t> payload;
+    return file.readChunk(index % REGION_SIZE, index / REGION_SIZE, payload, compression);
+}
+
+static void testCodecs() {
+    std::vector<BlockData> blocks = generated(ChunkCoord(0, 0));
+    std::vector<BlockData> decoded(BLOCKS_PER_CHUNK);
+    std::vector<uint8_t> encoded;
+
+    ChunkCodec::compress(blocks.data(), blocks.size(), encoded);
+    CHECK(ChunkCodec::decompress(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+    CHECK(decoded == blocks);
+
+    // Truncated runs, runs that stop short of the chunk and unknown block types are rejected
+    CHECK(!ChunkCodec::decompress(encoded.data(), encoded.size() - 1, decoded.data(), decoded.size()));
+    CHECK(!ChunkCodec::decompress(encoded.data(), encoded.size() - 4, decoded.data(), decoded.size()));
+    std::vector<uint8_t> badType = encoded;
+    badType[2] = static_cast<uint8_t>(BlockType::COUNT);
+    CHECK(!ChunkCodec::decompress(badType.data(), badType.size(), decoded.data(), decoded.size()));
+
+    std::vector<BlockData> edited = blocks;
+    edited[0] = BlockData(BlockType::COBBLESTONE);
+    edited[BLOCKS_PER_CHUNK / 2] = BlockData(BlockType::WOOD, 3);
+    edited[BLOCKS_PER_CHUNK - 1] = BlockData(BlockType::SAND);
+    CHECK(ChunkCodec::encodeDelta(edited.data(), blocks.data(), blocks.size(), encoded) == 3);
+    decoded = blocks;
+    CHECK(ChunkCodec::applyDelta(encoded.data(), encoded.size(), decoded.data(), decoded.size()));
+    CHECK(decoded == edited);
+
+    // A varint cut off mid-entry, or an entry missing its block bytes, is rejected
+    CHECK(!ChunkCodec::applyDelta(encoded.data(), encoded.size() - 1, decoded.data(), decoded.size()));
+    uint8_t openVarint[] = {0x80};
+    CHECK(!ChunkCodec::applyDelta(openVarint, sizeof(openVarint), decoded.data(), decoded.size()));
+}
+
+static void testSectorReuse() {
+    std::string path = TEST_DIR + "/sectors.mcr";
+    std::vector<uint8_t> threeSectors(REGION_SECTOR_SIZE * 3 - REGION_PAYLOAD_HEADER_SIZE, 0x11);
+    std::vector<uint8_t> oneSector(100, 0x22);
+    std::vector<uint8_t> fourSectors(REGION_SECTOR_SIZE * 4 - REGION_PAYLOAD_HEADER_SIZE, 0x33);
+    std::vector<uint8_t> payload;
+    RegionCompression compression;
+
+    {
+        RegionFile region(path);
+        CHECK(region.isOpen());
+        CHECK(region.writeChunk(0, 0, threeSectors.data(), threeSectors.size(), RegionCompression::NONE));
+        CHECK(region.writeChunk(1, 0, oneSector.data(), oneSector.size(), RegionCompression::RLE));
+        region.flush();
+        CHECK(fileSize(path) == static_cast<uintmax_t>(REGION_SECTOR_SIZE) * 5);
+
+        // A smaller payload is rewritten in place and the file does not grow
+        CHECK(region.writeChunk(1, 0, oneSector.data(), 10, RegionCompression::RLE));
+        region.flush();
+        CHECK(fileSize(path) == static_cast<uintmax_t>(REGION_SECTOR_SIZE) * 5);
+
+        // Growing (0, 0) moves it to the end and frees sectors 1..3 ...
+        CHECK(region.writeChunk(0, 0, fourSectors.data(), fourSectors.size(), RegionCompression::NONE));
+        region.flush();
+        CHECK(fileSize(path) == static_cast<uintmax_t>(REGION_SECTOR_SIZE) * 9);
+
+        // ... which the next three-sector chunk reuses instead of growing the file
+        CHECK(region.writeChunk(2, 0, threeSectors.data(), threeSectors.size(), RegionCompression::DELTA));
+        region.flush();
+        CHECK(fileSize(path) == static_cast<uintmax_t>(REGION_SECTOR_SIZE) * 9);
+
+        const uint8_t* mapped = nullptr;
+        size_t mappedSize = 0;
+        CHECK(region.mapChunk(2, 0, mapped, mappedSize, compression));
+        CHECK(compression == RegionCompression::DELTA && mappedSize == threeSectors.size());
+        CHECK(mappedSize == threeSectors.size() && std::memcmp(mapped, threeSectors.data(), mappedSize) == 0);
+    }
+
+    // Everything survives a reopen
+    RegionFile region(path);
+    CHECK(region.readChunk(0, 0, payload, compression));
+    CHECK(compression == RegionCompression::NONE && payload == fourSectors);
+    CHECK(region.readChunk(1, 0, payload, compression));
+    CHECK(compression == RegionCompression::RLE && payload == std::vector<uint8_t>(10, 0x22));
+    CHECK(region.readChunk(2, 0, payload, compression));
+    CHECK(compression == RegionCompression::DELTA && payload == threeSectors);
+    CHECK(!region.hasChunk(3, 0));
+}
+
+static void testStorageRoundTrips() {
+    std::string directory = TEST_DIR + "/storage";
+    ChunkCoord deltaCoord(0, 0), rleCoord(1, 0), rawCoord(-1, -1), cleanCoord(2, 0);
+
+    std::vector<BlockData> deltaBlocks = generated(deltaCoord);
+    deltaBlocks[CurrentChunkGeometry::blockIndex(3, 40, 5)] = BlockData(BlockType::COBBLESTONE);
+    deltaBlocks[CurrentChunkGeometry::blockIndex(4, 41, 5)] = BlockData(BlockType::AIR);
+
+    // A rebuilt chunk is cheaper as a snapshot than as a delta
+    std::vector<BlockData> rleBlocks(BLOCKS_PER_CHUNK, BlockData(BlockType::STONE));
+
+    // Noise encodes larger than raw storage either way
+    std::vector<BlockData> rawBlocks(BLOCKS_PER_CHUNK);
+    uint32_t seed = 12345;
+    for (BlockData& block : rawBlocks) {
+        seed = seed * 1664525u + 1013904223u;
+        block = BlockData(static_cast<BlockType>((seed >> 16) % static_cast<uint32_t>(BlockType::COUNT)),
+                          static_cast<uint8_t>(seed >> 24));
+    }
+
+    {
+        ChunkStorage storage(directory, TEST_SEED);
+        size_t written = 0;
+        CHECK(storage.saveChunk(deltaCoord, deltaBlocks.data(), &written) && written > 0);
+        CHECK(storage.saveChunk(rleCoord, rleBlocks.data(), &written) && written > 0);
+        CHECK(storage.saveChunk(rawCoord, rawBlocks.data(), &written) && written > 0);
+        CHECK(storage.saveChunk(cleanCoord, generated(cleanCoord).data(), &written) && written == 0);
+
+        // Loads see the writes through the mapping before anything is flushed
+        std::vector<BlockData> loaded(BLOCKS_PER_CHUNK);
+        CHECK(storage.loadChunk(deltaCoord, loaded.data()) && loaded == deltaBlocks);
+        CHECK(storage.loadChunk(rleCoord, loaded.data()) && loaded == rleBlocks);
+        CHECK(storage.loadChunk(rawCoord, loaded.data()) && loaded == rawBlocks);
+        CHECK(!storage.loadChunk(cleanCoord, loaded.data()));
+        storage.sync();
+    }
+
+    RegionCompression compression;
+    CHECK(storedCompression(directory, deltaCoord, compression) && compression == RegionCompression::DELTA);
+    CHECK(storedCompression(directory, rleCoord, compression) && compression == RegionCompression::RLE);
+    CHECK(storedCompression(directory, rawCoord, compression) && compression == RegionCompression::NONE);
+    CHECK(!storedCompression(directory, cleanCoord, compression));
+
+    ChunkStorage storage(directory, TEST_SEED);
+    std::vector<BlockData> loaded(BLOCKS_PER_CHUNK);
+    CHECK(storage.loadChunk(deltaCoord, loaded.data()) && loaded == deltaBlocks);
+    CHECK(storage.loadChunk(rleCoord, loaded.data()) && loaded == rleBlocks);
+    CHECK(storage.loadChunk(rawCoord, loaded.data()) && loaded == rawBlocks);
+
+    // Saving generator output again drops the stored delta
+    CHECK(storage.saveChunk(deltaCoord, generated(deltaCoord).data()));
+    CHECK(!storage.loadChunk(deltaCoord, loaded.data()));
+}
+
+static void testCorruptPayloads() {
+    std::string directory = TEST_DIR + "/corrupt";
+    std::string path = directory + "/r.0.0.mcr";
+    std::filesystem::create_directories(directory);
+
+    std::vector<uint8_t> rle;
+    std::vector<BlockData> blocks(BLOCKS_PER_CHUNK, BlockData(BlockType::DIRT));
+    ChunkCodec::compress(blocks.data(), blocks.size(), rle);
+    std::vector<uint8_t> large(REGION_SECTOR_SIZE * 2, 0x44);
+    {
+        RegionFile region(path);
+        CHECK(region.writeChunk(0, 0, rle.data(), rle.size(), RegionCompression::RLE));
+        CHECK(region.writeChunk(1, 0, rle.data(), rle.size(), RegionCompression::RLE));
+        CHECK(region.writeChunk(2, 0, rle.data(), rle.size(), RegionCompression::NONE));
+        CHECK(region.writeChunk(3, 0, large.data(), large.size(), RegionCompression::RLE));
+    }
+
+    // Sector layout: header, (0,0), (1,0), (2,0), then three sectors for (3,0)
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    CHECK(file != nullptr);
+    if (!file) return;
+
+    // (0,0): a length running past its sectors
+    uint8_t hugeLength[4] = {0xFF, 0xFF, 0x00, 0x00};
+    std::fseek(file, REGION_SECTOR_SIZE * 1, SEEK_SET);
+    std::fwrite(hugeLength, 1, sizeof(hugeLength), file);
+
+    // (1,0): an RLE run with an unknown block type
+    uint8_t badType = static_cast<uint8_t>(BlockType::COUNT);
+    std::fseek(file, REGION_SECTOR_SIZE * 2 + REGION_PAYLOAD_HEADER_SIZE + 2, SEEK_SET);
+    std::fwrite(&badType, 1, 1, file);
+    std::fclose(file);
+
+    // (3,0): the file is cut off in the middle of the last payload (torn write)
+    std::filesystem::resize_file(path, REGION_SECTOR_SIZE * 5 + 100);
+
+    {
+        RegionFile region(path);
+        std::vector<uint8_t> payload;
+        RegionCompression compression;
+        const uint8_t* mapped = nullptr;
+        size_t mappedSize = 0;
+        CHECK(!region.readChunk(0, 0, payload, compression));
+        CHECK(!region.mapChunk(0, 0, mapped, mappedSize, compression));
+        CHECK(!region.hasChunk(3, 0));
+    }
+
+    ChunkStorage storage(directory, TEST_SEED);
+    std::vector<BlockData> loaded(BLOCKS_PER_CHUNK);
+    CHECK(!storage.loadChunk(ChunkCoord(0, 0), loaded.data()));
+    CHECK(!storage.loadChunk(ChunkCoord(1, 0), loaded.data()));
+    CHECK(!storage.loadChunk(ChunkCoord(2, 0), loaded.data()));   // NONE payload of the wrong size
+    CHECK(!storage.loadChunk(ChunkCoord(3, 0), loaded.data()));
+}
+
+static void testSaveInfo() {
+    std::string directory = TEST_DIR + "/info";
+    ChunkCoord coord(0, 0);
+    std::vector<BlockData> blocks(BLOCKS_PER_CHUNK, BlockData(BlockType::STONE));
+    std::vector<BlockData> loaded(BLOCKS_PER_CHUNK);
+
+    {
+        ChunkStorage storage(directory, TEST_SEED);
+        CHECK(storage.getIncompatiblePath().empty());
+        CHECK(storage.saveChunk(coord, blocks.data()));
+    }
+    CHECK(std::filesystem::exists(directory + "/save.info"));
+
+    // Reopening with the same seed and build keeps the save
+    {
+        ChunkStorage storage(directory, TEST_SEED);
+        CHECK(storage.getIncompatiblePath().empty());
+        CHECK(storage.loadChunk(coord, loaded.data()) && loaded == blocks);
+    }
+
+    // Another seed's save is moved aside and chunks fall back to the generator
+    {
+        ChunkStorage storage(directory, TEST_SEED + 1);
+        CHECK(!storage.getIncompatiblePath().empty());
+        CHECK(std::filesystem::exists(storage.getIncompatiblePath() + "/r.0.0.mcr"));
+        CHECK(!storage.loadChunk(coord, loaded.data()));
+        CHECK(storage.saveChunk(coord, blocks.data()));
+    }
+
+    // So is a save from another generator version, or one without save.info at all
+    {
+        std::ofstream info(directory + "/save.info", std::ios::trunc);
+        info << "format " << REGION_FORMAT_VERSION << "\ngenerator " << Chunk::GENERATOR_VERSION + 1
+             << "\nseed " << TEST_SEED + 1 << "\n";
+    }
+    {
+        ChunkStorage storage(directory, TEST_SEED + 1);
+        CHECK(!storage.getIncompatiblePath().empty());
+        CHECK(!storage.loadChunk(coord, loaded.data()));
+        CHECK(storage.saveChunk(coord, blocks.data()));
+    }
+    std::filesystem::remove(directory + "/save.info");
+    {
+        ChunkStorage storage(directory, TEST_SEED + 1);
+        CHECK(!storage.getIncompatiblePath().empty());
+        CHECK(!storage.loadChunk(coord, loaded.data()));
+    }
+}
+
+int main() {
+    std::filesystem::remove_all(TEST_DIR);
+    std::filesystem::create_directories(TEST_DIR);
+
+    testCodecs();
+    testSectorReuse();
+    testStorageRoundTrips();
+    testCorruptPayloads();
+    testSaveInfo();
+
+    std::filesystem::remove_all(TEST_DIR);
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "region_file_test passed" << std::endl;
+    return 0;
+}